@@ -1,7 +1,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <string>
+#include <type_traits>
 
 #include <benchmark/benchmark.h>
 
@@ -117,4 +121,108 @@ static void BM_groupby_large_table(benchmark::State &state) {
 
 BENCHMARK(BM_groupby_large_table)->RangeMultiplier(2)->Range(64, 2 << 20);
 
+// Group labels for group sizes varying by four orders of magnitude, such that
+// the cost of processing a group is dominated by few large groups.
+auto make_skewed_groups(const scipp::index size, const scipp::index nGroup) {
+  std::vector<double> bound(nGroup);
+  for (scipp::index g = 0; g < nGroup; ++g)
+    bound[g] = std::pow(1e4, static_cast<double>(g) / (nGroup - 1));
+  std::partial_sum(bound.begin(), bound.end(), bound.begin());
+  std::vector<int64_t> group(size);
+  for (scipp::index i = 0; i < size; ++i)
+    group[i] = std::upper_bound(bound.begin(), bound.end(),
+                                bound.back() * i / size) -
+               bound.begin();
+  return makeVariable<int64_t>(Dims{Dim::X}, Shape{size},
+                               Values(group.begin(), group.end()));
+}
+
+static void BM_groupby_flatten_skewed(benchmark::State &state) {
+  const scipp::index nEvent = 1e8;
+  const scipp::index nHist = state.range(0);
+  const scipp::index nGroup = state.range(1);
+  auto sparse = make_2d_sparse<double>(nHist, nEvent / nHist);
+  sparse.labels().set("group", make_skewed_groups(nHist, nGroup));
+  for (auto _ : state) {
+    auto flat = groupby(sparse, "group", Dim::Z).flatten(Dim::X);
+    state.PauseTiming();
+    flat = DataArray();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nEvent);
+  state.SetBytesProcessed(state.iterations() * (2 * nEvent * 3) *
+                          sizeof(double));
+  state.counters["groups"] = nGroup;
+  state.counters["inputs"] = nHist;
+}
+// Params are:
+// - nHist
+// - nGroup
+BENCHMARK(BM_groupby_flatten_skewed)
+    ->RangeMultiplier(4)
+    ->Ranges({{1 << 14, 1 << 18}, {16, 256}})
+    ->UseRealTime();
+
+static void BM_groupby_sum_skewed(benchmark::State &state) {
+  const scipp::index nRow = state.range(0);
+  const scipp::index nCol = 64;
+  const scipp::index nGroup = state.range(1);
+  DataArray a(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{nCol, nRow}),
+              {}, {{"group", make_skewed_groups(nRow, nGroup)}});
+  for (auto _ : state) {
+    auto summed = groupby(a, "group", Dim::Z).sum(Dim::X);
+    state.PauseTiming();
+    summed = DataArray();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nRow * nCol);
+  state.SetBytesProcessed(state.iterations() * nRow * nCol * sizeof(double));
+  state.counters["groups"] = nGroup;
+}
+// Params are:
+// - nRow
+// - nGroup
+BENCHMARK(BM_groupby_sum_skewed)
+    ->RangeMultiplier(4)
+    ->Ranges({{1 << 14, 1 << 18}, {16, 256}})
+    ->UseRealTime();
+
+// Grouping of a large table with shuffled keys, i.e., without any contiguous
+// runs of rows with the same key, such as a spectrum-to-group mapping.
+template <class T> static void BM_groupby_make_groups(benchmark::State &state) {
+  const scipp::index nRow = 10000000;
+  const scipp::index nGroup = state.range(0);
+  std::vector<T> group_(nRow);
+  for (scipp::index i = 0; i < nRow; ++i) {
+    const auto group = (i * 7919) % nGroup;
+    if constexpr (std::is_same_v<T, std::string>)
+      group_[i] = "group_" + std::to_string(group);
+    else
+      group_[i] = static_cast<T>(group);
+  }
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{nRow}));
+  a.labels().set("group",
+                 makeVariable<T>(Dims{Dim::X}, Shape{nRow},
+                                 Values(group_.begin(), group_.end())));
+  for (auto _ : state) {
+    auto grouped = groupby(a, "group", Dim::Y);
+    benchmark::DoNotOptimize(grouped);
+  }
+  state.SetItemsProcessed(state.iterations() * nRow);
+  state.counters["groups"] = nGroup;
+}
+
+BENCHMARK_TEMPLATE(BM_groupby_make_groups, int64_t)
+    ->RangeMultiplier(100)
+    ->Range(10, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_groupby_make_groups, double)
+    ->RangeMultiplier(100)
+    ->Range(10, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_groupby_make_groups, std::string)
+    ->RangeMultiplier(100)
+    ->Range(10, 100000)
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
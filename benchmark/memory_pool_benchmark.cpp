@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "scipp/core/memory_pool.h"
+#include "scipp/core/parallel.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+struct Malloc {
+  static void *allocate(const size_t size) { return std::malloc(size); }
+  static void deallocate(void *ptr) { std::free(ptr); }
+};
+
+struct Pool {
+  static void *allocate(const size_t size) { return instance().allocate(size); }
+  static void deallocate(void *ptr) { instance().deallocate(ptr); }
+};
+
+// Mimics a parallel transform creating a temporary output per task, which is
+// the typical allocation pattern of scipp operations running in parallel.
+template <class Allocator>
+static void BM_MemoryPool_parallel_transform(benchmark::State &state) {
+  const scipp::index tasks = 1024;
+  const scipp::index size = state.range(0);
+  for (auto _ : state) {
+    parallel::parallel_for(
+        parallel::blocked_range(0, tasks, 1), [&](const auto &range) {
+          for (auto i = range.begin(); i < range.end(); ++i) {
+            auto *out = static_cast<double *>(
+                Allocator::allocate(size * sizeof(double)));
+            std::fill(out, out + size, static_cast<double>(i));
+            std::transform(out, out + size, out,
+                           [](const double x) { return x * x; });
+            benchmark::DoNotOptimize(out[size / 2]);
+            Allocator::deallocate(out);
+          }
+        });
+  }
+  state.SetItemsProcessed(state.iterations() * tasks);
+  state.SetBytesProcessed(state.iterations() * tasks * size * sizeof(double));
+  if constexpr (std::is_same_v<Allocator, Pool>)
+    state.counters["hit-rate"] = instance().statistics().hit_rate();
+}
+// Small, medium, and large (beyond typical mmap threshold of malloc) sizes.
+BENCHMARK_TEMPLATE(BM_MemoryPool_parallel_transform, Malloc)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 20)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MemoryPool_parallel_transform, Pool)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 20)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <numeric>
+
+#include <benchmark/benchmark.h>
+
+#include "random.h"
+
+#include "scipp/core/dataset.h"
+#include "scipp/core/packed_events.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+auto make_sparse(const scipp::index size, const scipp::index count) {
+  auto var = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                  Shape{size, Dimensions::Sparse});
+  auto vals = var.sparseValues<double>();
+  Random rand(0.0, 1000.0);
+  for (scipp::index i = 0; i < size; ++i) {
+    auto data = rand(count);
+    vals[i].assign(data.begin(), data.end());
+  }
+  return var;
+}
+
+auto make_edges(const scipp::index nEdge) {
+  std::vector<double> edges(nEdge);
+  std::iota(edges.begin(), edges.end(), 0.0);
+  auto var = makeVariable<double>(Dims{Dim::Y}, Shape{nEdge},
+                                  Values(edges.begin(), edges.end()));
+  var *= 1000.0 / nEdge;
+  return var;
+}
+
+template <class Func>
+static void run(benchmark::State &state, const scipp::index nEvent,
+                const scipp::index nHist, Func func) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(func());
+  }
+  state.SetItemsProcessed(state.iterations() * nHist * nEvent);
+  state.SetBytesProcessed(state.iterations() * nHist * nEvent *
+                          sizeof(double));
+  state.counters["events/s"] = benchmark::Counter(
+      nHist * nEvent, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_sparse_copy(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const auto var = make_sparse(nHist, nEvent);
+  run(state, nEvent, nHist, [&]() { return Variable(var); });
+}
+
+static void BM_packed_copy(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const auto packed = sparse::pack(make_sparse(nHist, nEvent));
+  run(state, nEvent, nHist, [&]() { return copy(packed); });
+}
+
+static void BM_pack(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const auto var = make_sparse(nHist, nEvent);
+  run(state, nEvent, nHist, [&]() { return sparse::pack(var); });
+}
+
+static void BM_unpack(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const auto packed = sparse::pack(make_sparse(nHist, nEvent));
+  run(state, nEvent, nHist, [&]() { return sparse::unpack(packed); });
+}
+
+static void BM_sparse_histogram(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const DataArray sparse(std::nullopt,
+                         {{Dim::Y, make_sparse(nHist, nEvent)}});
+  const auto edges = make_edges(state.range(1));
+  run(state, nEvent, nHist, [&]() { return histogram(sparse, edges); });
+}
+
+static void BM_packed_histogram(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nHist = 1e7 / nEvent;
+  const auto packed = sparse::pack(make_sparse(nHist, nEvent));
+  const auto edges = make_edges(state.range(1));
+  run(state, nEvent, nHist, [&]() { return histogram(packed, edges); });
+}
+
+// Params are:
+// - nEvent
+BENCHMARK(BM_sparse_copy)->RangeMultiplier(4)->Range(1, 2 << 14);
+BENCHMARK(BM_packed_copy)->RangeMultiplier(4)->Range(1, 2 << 14);
+BENCHMARK(BM_pack)->RangeMultiplier(4)->Range(1, 2 << 14);
+BENCHMARK(BM_unpack)->RangeMultiplier(4)->Range(1, 2 << 14);
+
+// Params are:
+// - nEvent
+// - nEdge
+BENCHMARK(BM_sparse_histogram)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 2 << 14}, {128, 2 << 11}});
+BENCHMARK(BM_packed_histogram)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 2 << 14}, {128, 2 << 11}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "scipp/core/dataset.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+auto make_edges(const Dim dim, const scipp::index nEdge, const double width,
+                const double shift) {
+  std::vector<double> edges(nEdge);
+  for (scipp::index i = 0; i < nEdge; ++i)
+    edges[i] = i * width + shift;
+  return makeVariable<double>(Dims{dim}, Shape{nEdge},
+                              Values(edges.begin(), edges.end()));
+}
+
+auto make_data(const Dimensions &dims) {
+  const std::vector<double> ones(dims.volume(), 1.0);
+  return makeVariable<double>(Dimensions(dims), units::Unit(units::counts),
+                              Values(ones.begin(), ones.end()),
+                              Variances(ones.begin(), ones.end()));
+}
+
+// Rebin outer dimension to half the number of bins, with new edges not
+// aligned with old edges.
+static void BM_rebin_outer(benchmark::State &state) {
+  const scipp::index nBin = state.range(0);
+  const scipp::index nInner = state.range(1);
+  const auto data = make_data(Dimensions{{Dim::Y, nBin}, {Dim::X, nInner}});
+  const auto oldEdges = make_edges(Dim::Y, nBin + 1, 1.0, 0.0);
+  const auto newEdges = make_edges(Dim::Y, nBin / 2 + 1, 2.0, 0.3);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(rebin(data, Dim::Y, oldEdges, newEdges));
+  state.SetItemsProcessed(state.iterations() * data.dims().volume());
+  // Read values and variances, write half of that.
+  state.SetBytesProcessed(state.iterations() * 3 * data.dims().volume() *
+                          sizeof(double));
+}
+
+BENCHMARK(BM_rebin_outer)
+    ->RangeMultiplier(10)
+    ->Ranges({{20, 2000}, {100, 100000}})
+    ->Unit(benchmark::kMillisecond);
+
+// Rebin inner dimension to half the number of bins, with new edges not
+// aligned with old edges, shared by all spectra or given per spectrum.
+static void BM_rebin_inner(benchmark::State &state) {
+  const scipp::index nSpec = state.range(0);
+  const scipp::index nBin = state.range(1);
+  const bool shared = state.range(2);
+  const auto data = make_data(Dimensions{{Dim::Y, nSpec}, {Dim::X, nBin}});
+  const auto oldEdges = make_edges(Dim::X, nBin + 1, 1.0, 0.0);
+  auto newEdges = make_edges(Dim::X, nBin / 2 + 1, 2.0, 0.3);
+  if (!shared)
+    newEdges = broadcast(newEdges, {{Dim::Y, nSpec}, {Dim::X, nBin / 2 + 1}});
+  for (auto _ : state)
+    benchmark::DoNotOptimize(rebin(data, Dim::X, oldEdges, newEdges));
+  state.SetItemsProcessed(state.iterations() * data.dims().volume());
+  state.SetBytesProcessed(state.iterations() * 3 * data.dims().volume() *
+                          sizeof(double));
+  state.counters["shared-edges"] = shared;
+}
+
+// Params are:
+// - number of spectra
+// - number of bins
+// - new edges shared by all spectra
+BENCHMARK(BM_rebin_inner)
+    ->RangeMultiplier(10)
+    ->Ranges({{100, 10000}, {100, 10000}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
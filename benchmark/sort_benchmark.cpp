@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <numeric>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "scipp/core/sort.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+auto make_table(const scipp::index nRow) {
+  std::vector<double> key_(nRow);
+  std::iota(key_.begin(), key_.end(), 0.0);
+  std::mt19937 mt(12345);
+  std::shuffle(key_.begin(), key_.end(), mt);
+  Dataset d;
+  const auto column = makeVariable<double>(Dims{Dim::X}, Shape{nRow});
+  d.setData("a", column);
+  d.setData("b", column);
+  d.setData("c", column);
+  d.setCoord(Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{nRow},
+                                          Values(key_.begin(), key_.end())));
+  return d;
+}
+
+static void BM_sort_dataset(benchmark::State &state) {
+  const scipp::index nCol = 4;
+  const scipp::index nRow = state.range(0);
+  const auto d = make_table(nRow);
+  for (auto _ : state) {
+    auto sorted = sort(d, Dim::X);
+    state.PauseTiming();
+    sorted = Dataset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nRow);
+  state.SetBytesProcessed(state.iterations() * 2 * nCol * nRow *
+                          sizeof(double));
+}
+
+// Params are:
+// - nRow
+BENCHMARK(BM_sort_dataset)->RangeMultiplier(10)->Range(1e5, 1e7);
+
+static void BM_sort_variable_2d(benchmark::State &state) {
+  const scipp::index nRow = state.range(0);
+  const scipp::index nCol = state.range(1);
+  const auto d = make_table(nRow);
+  const auto var =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{nRow, nCol});
+  for (auto _ : state) {
+    auto sorted = sort(var, d.coords()[Dim::X]);
+    state.PauseTiming();
+    sorted = Variable();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nRow);
+  state.SetBytesProcessed(state.iterations() * 2 * nCol * nRow *
+                          sizeof(double));
+}
+
+// Params are:
+// - nRow
+// - nCol
+BENCHMARK(BM_sort_variable_2d)
+    ->RangeMultiplier(10)
+    ->Ranges({{1e5, 1e7}, {1, 10}});
+
+BENCHMARK_MAIN();
@@ -36,9 +36,14 @@ auto make_2d_sparse(const scipp::index size, const scipp::index count) {
   return DataArray(std::move(data), {{Dim::Y, std::move(coord)}});
 }
 
-auto make_histogram(const scipp::index nEdge) {
+auto make_histogram(const scipp::index nEdge, const bool linear) {
   std::vector<double> edges_(nEdge);
   std::iota(edges_.begin(), edges_.end(), 0.0);
+  // Quadratic spacing for non-linear edges, as for, e.g., wavelength bins
+  // derived from a time-of-flight binning.
+  if (!linear)
+    for (auto &edge : edges_)
+      edge *= edge / (nEdge - 1);
   auto edges = makeVariable<double>(Dims{Dim::Y}, Shape{nEdge},
                                     Values(edges_.begin(), edges_.end()));
   edges *= 1000.0 / nEdge; // ensure all events are in range
@@ -71,9 +76,10 @@ static void BM_sparse_histogram_op(benchmark::State &state) {
   const bool inplace = state.range(2);
   const scipp::index nHist = 2e7 / nEvent;
   const bool data = state.range(3);
+  const bool linear = state.range(4);
   const auto sparse = data ? make_2d_sparse(nHist, nEvent)
                            : make_2d_sparse_coord_only(nHist, nEvent);
-  const auto histogram = make_histogram(nEdge);
+  const auto histogram = make_histogram(nEdge, linear);
   for (auto _ : state) {
     if (inplace) {
       state.PauseTiming();
@@ -95,6 +101,7 @@ static void BM_sparse_histogram_op(benchmark::State &state) {
   state.counters["sparse-with-data"] = data;
   state.counters["total_events"] = total_events;
   state.counters["inplace"] = inplace;
+  state.counters["linear"] = linear;
 }
 
 // Params are:
@@ -102,8 +109,13 @@ static void BM_sparse_histogram_op(benchmark::State &state) {
 // - nEdge
 // - inplace
 // - sparse with data
+// - linear bin edges
 BENCHMARK(BM_sparse_histogram_op)
     ->RangeMultiplier(4)
-    ->Ranges({{64, 2 << 14}, {128, 2 << 11}, {true, false}, {true, false}});
+    ->Ranges({{64, 2 << 14},
+              {128, 2 << 11},
+              {false, true},
+              {false, true},
+              {false, true}});
 
 BENCHMARK_MAIN();
@@ -15,8 +15,8 @@ using namespace scipp::core;
 using Types = std::tuple<std::pair<double, double>>;
 
 template <bool in_place, class Func>
-void run(benchmark::State &state, Func func, bool variances = false) {
-  const auto nx = 100;
+void run(benchmark::State &state, Func func, bool variances = false,
+         const scipp::index nx = 100) {
   const auto ny = state.range(0);
   const auto n = nx * ny;
   const Dimensions dims{{Dim::Y, ny}, {Dim::X, nx}};
@@ -62,33 +62,40 @@ static void BM_transform_in_place_view(benchmark::State &state) {
                 transform_in_place<Types>(a_view, b_view, op);
               }
             },
-            state.range(1));
+            state.range(1), state.range(2));
 }
 
 static void BM_transform_in_place_slice(benchmark::State &state) {
   run<true>(state,
             [](auto &state_, auto &a, auto &b, auto &op) {
-              // Strictly speaking our counters are off by 1% since we
-              // exclude 1 out of 100 X elements here.
-              auto a_slice = a.slice({Dim::X, 0, 99});
-              auto b_slice = b.slice({Dim::X, 1, 100});
+              // Strictly speaking our counters are off by 1/nx since we
+              // exclude 1 out of nx X elements here.
+              const auto nx = a.dims()[Dim::X];
+              auto a_slice = a.slice({Dim::X, 0, nx - 1});
+              auto b_slice = b.slice({Dim::X, 1, nx});
               for ([[maybe_unused]] auto _ : state_) {
                 transform_in_place<Types>(a_slice, b_slice, op);
               }
             },
-            state.range(1));
+            state.range(1), state.range(2));
 }
 
-// {false, true} -> variances
+// Arguments are:
+// range(0) -> ny
+// range(1) -> variances false/true
+// range(2) -> nx (views and slices only), small nx stresses the iteration
+//             over the outer dimension
 BENCHMARK(BM_transform_in_place)
     ->RangeMultiplier(2)
     ->Ranges({{1, 2 << 18}, {false, true}});
 BENCHMARK(BM_transform_in_place_view)
     ->RangeMultiplier(2)
-    ->Ranges({{1, 2 << 18}, {false, true}});
+    ->Ranges({{1, 2 << 18}, {false, true}, {100, 100}})
+    ->Ranges({{2 << 12, 2 << 12}, {false, true}, {2, 2 << 10}});
 BENCHMARK(BM_transform_in_place_slice)
     ->RangeMultiplier(2)
-    ->Ranges({{1, 2 << 18}, {false, true}});
+    ->Ranges({{1, 2 << 18}, {false, true}, {100, 100}})
+    ->Ranges({{2 << 12, 2 << 12}, {false, true}, {2, 2 << 10}});
 
 static void BM_transform(benchmark::State &state) {
   run<false>(state,
@@ -115,16 +122,17 @@ static void BM_transform_view(benchmark::State &state) {
                  state_.ResumeTiming();
                }
              },
-             state.range(1));
+             state.range(1), state.range(2));
 }
 
 static void BM_transform_slice(benchmark::State &state) {
   run<false>(state,
              [](auto &state_, auto &a, auto &b, auto &op) {
-               // Strictly speaking our counters are off by 1% since we
-               // exclude 1 out of 100 X elements here.
-               auto a_slice = a.slice({Dim::X, 0, 99});
-               auto b_slice = b.slice({Dim::X, 1, 100});
+               // Strictly speaking our counters are off by 1/nx since we
+               // exclude 1 out of nx X elements here.
+               const auto nx = a.dims()[Dim::X];
+               auto a_slice = a.slice({Dim::X, 0, nx - 1});
+               auto b_slice = b.slice({Dim::X, 1, nx});
                for ([[maybe_unused]] auto _ : state_) {
                  auto out = transform<Types>(a_slice, b_slice, op);
                  state_.PauseTiming();
@@ -132,19 +140,21 @@ static void BM_transform_slice(benchmark::State &state) {
                  state_.ResumeTiming();
                }
              },
-             state.range(1));
+             state.range(1), state.range(2));
 }
 
-// {false, true} -> variances
+// Arguments as for the in-place benchmarks above.
 BENCHMARK(BM_transform)
     ->RangeMultiplier(2)
     ->Ranges({{1, 2 << 18}, {false, true}});
 BENCHMARK(BM_transform_view)
     ->RangeMultiplier(2)
-    ->Ranges({{1, 2 << 18}, {false, true}});
+    ->Ranges({{1, 2 << 18}, {false, true}, {100, 100}})
+    ->Ranges({{2 << 12, 2 << 12}, {false, true}, {2, 2 << 10}});
 BENCHMARK(BM_transform_slice)
     ->RangeMultiplier(2)
-    ->Ranges({{1, 2 << 18}, {false, true}});
+    ->Ranges({{1, 2 << 18}, {false, true}, {100, 100}})
+    ->Ranges({{2 << 12, 2 << 12}, {false, true}, {2, 2 << 10}});
 
 // Arguments are:
 // range(0) -> ny
@@ -5,9 +5,12 @@
 #include "scipp/common/numeric.h"
 #include "scipp/core/dataset.h"
 #include "scipp/core/histogram.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/subspan_view.h"
 #include "scipp/core/transform.h"
 
+#include "histogram_lookup.h"
+
 namespace scipp::core {
 
 template <class T> auto copy_map(const T &map) {
@@ -106,8 +109,21 @@ auto apply_op_sparse_dense(Op op, const Coord &coord, const Data &data,
       }
     }
   } else {
-    expect::histogram::sorted_edges(edges);
-    throw std::runtime_error("Non-constant bin width not supported yet.");
+    using Edge = std::decay_t<decltype(edges[0])>;
+    const histogram_detail::EdgeLookup<Edge> lookup(edges);
+    for (const auto c : coord) {
+      const auto bin = lookup(c);
+      auto w = get(weights, bin < 0 ? 0 : bin);
+      if (bin < 0)
+        w = 0.0;
+      if constexpr (vars) {
+        const auto [val, var] = op(d, w);
+        out_vals.emplace_back(val);
+        out_vars.emplace_back(var);
+      } else {
+        out_vals.emplace_back(op(d, w));
+      }
+    }
   }
   if constexpr (vars)
     return std::pair(std::move(out_vals), std::move(out_vars));
@@ -152,6 +168,162 @@ Variable sparse_dense_op_impl(Op op, const VariableConstView &sparseCoord_,
           }});
 }
 
+namespace sparse_dense_op_inplace_detail {
+/// Apply `op` in place to the weights of the events in a single event list,
+/// with the histogram value of the bin containing each event. Events outside
+/// the histogram get a histogram value of 0, as in sparse_dense_op_impl.
+template <bool DataVariances, bool WeightVariances, class Op, class T,
+          class Coord, class Edge>
+void apply_to_events(Op op, sparse_container<T> &vals,
+                     sparse_container<T> &vars,
+                     const sparse_container<Coord> &coord,
+                     const span<const T> &weights,
+                     const span<const T> &weight_vars,
+                     const histogram_detail::EdgeLookup<Edge> &lookup) {
+  const auto weight = [&](const scipp::index bin) {
+    if constexpr (WeightVariances)
+      return bin < 0 ? ValueAndVariance<T>{0, 0}
+                     : ValueAndVariance<T>{weights[bin], weight_vars[bin]};
+    else
+      return bin < 0 ? T{0} : weights[bin];
+  };
+  const auto apply = [&](const scipp::index i, const scipp::index bin) {
+    if constexpr (DataVariances) {
+      const auto [val, var] = op(ValueAndVariance<T>{vals[i], vars[i]},
+                                 weight(bin));
+      vals[i] = val;
+      vars[i] = var;
+    } else {
+      vals[i] = op(vals[i], weight(bin));
+    }
+  };
+  const auto size = scipp::size(coord);
+  if (lookup.linear()) {
+    const auto [offset, nbin, scale] = linear_edge_params(lookup.edges());
+    for (scipp::index i = 0; i < size; ++i) {
+      const auto bin = (coord[i] - offset) * scale;
+      apply(i, bin >= 0 && bin < nbin ? static_cast<scipp::index>(bin) : -1);
+    }
+  } else {
+    for (scipp::index i = 0; i < size; ++i)
+      apply(i, lookup(coord[i]));
+  }
+}
+
+template <bool DataVariances, bool WeightVariances, class T, class Coord,
+          class Edge, class Op>
+void apply_to_lists(Op op, const VariableView &data,
+                    const VariableConstView &coord,
+                    const VariableConstView &edges,
+                    const VariableConstView &weights) {
+  const Dim dim = data.dims().sparseDim();
+  const auto dense = denseDims(data.dims());
+  const auto edge_spans = subspan_view(edges, dim);
+  const auto weight_spans = subspan_view(weights, dim);
+  // Lookups are built once if the edges are shared by all event lists, and
+  // per event list otherwise. In the latter case edges are validated upfront
+  // such that a failure does not leave `data` partially modified.
+  std::optional<histogram_detail::EdgeLookup<Edge>> shared;
+  if (edge_spans.dims().ndim() == 0)
+    shared.emplace(edge_spans.values<span<const Edge>>()[0]);
+  else
+    for (const auto &row : edge_spans.values<span<const Edge>>())
+      if (!scipp::numeric::is_linspace(row))
+        expect::histogram::sorted_edges(row);
+
+  const auto vals = data.sparseValues<T>();
+  const auto vars = DataVariances ? data.sparseVariances<T>() : vals;
+  const auto coords = coord.sparseValues<Coord>();
+  // Histogram dimensions are broadcast to the dense dimensions of `data`.
+  const auto &edges_concept =
+      static_cast<const VariableConceptT<span<const Edge>> &>(
+          edge_spans.data());
+  const auto &weights_concept =
+      static_cast<const VariableConceptT<span<const T>> &>(weight_spans.data());
+  const auto edges_ = edges_concept.valuesView(dense);
+  const auto weights_ = weights_concept.valuesView(dense);
+  const auto weight_vars_ = WeightVariances
+                                ? weights_concept.variancesView(dense)
+                                : weights_;
+  parallel::parallel_for(
+      parallel::blocked_range(0, dense.volume()), [&](const auto &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          const auto run = [&](const auto &lookup) {
+            apply_to_events<DataVariances, WeightVariances>(
+                op, vals[i], vars[i], coords[i], weights_[i], weight_vars_[i],
+                lookup);
+          };
+          if (shared)
+            run(*shared);
+          else
+            run(histogram_detail::EdgeLookup<Edge>(edges_[i]));
+        }
+      });
+}
+
+template <class T, class Coord, class Edge, class Op>
+void apply_to_lists(Op op, const VariableView &data,
+                    const VariableConstView &coord,
+                    const VariableConstView &edges,
+                    const VariableConstView &weights) {
+  if (data.hasVariances() && weights.hasVariances())
+    apply_to_lists<true, true, T, Coord, Edge>(op, data, coord, edges, weights);
+  else if (data.hasVariances())
+    apply_to_lists<true, false, T, Coord, Edge>(op, data, coord, edges,
+                                                weights);
+  else
+    apply_to_lists<false, false, T, Coord, Edge>(op, data, coord, edges,
+                                                 weights);
+}
+
+/// Return true if the fused in-place kernel supports the given sparse data
+/// and histogram. Other cases are handled by the generic implementation,
+/// which creates temporary sparse data.
+bool is_supported(const VariableConstView &data,
+                  const VariableConstView &coord,
+                  const VariableConstView &edges,
+                  const VariableConstView &weights) {
+  const auto type = data.dtype();
+  const auto is_float = [](const DType t) {
+    return t == dtype<double> || t == dtype<float>;
+  };
+  const auto dense = denseDims(data.dims());
+  const auto contained = [&dense](Dimensions dims) {
+    dims.erase(dims.inner());
+    return dense.contains(dims);
+  };
+  return is_float(type) && weights.dtype() == type &&
+         edges.dtype() == type && is_float(coord.dtype()) &&
+         coord.dims() == data.dims() &&
+         (data.hasVariances() || !weights.hasVariances()) &&
+         contained(edges.dims()) && contained(weights.dims());
+}
+
+/// Apply `op` to the weights of sparse data in place, using the value of the
+/// histogram bin containing the event as second operand. The histogram is
+/// given by `edges` and `weights`, with the sparse dimension as inner
+/// dimension and optional dense dimensions that are broadcast. Work is done
+/// in parallel over event lists and no temporary sparse data is created.
+template <class Op>
+void apply(Op op, const VariableView &data, const VariableConstView &coord,
+           const VariableConstView &edges, const VariableConstView &weights) {
+  expect::equals(coord.unit(), edges.unit());
+  const auto unit = op(data.unit(), weights.unit());
+  if (data.dtype() == dtype<double>) {
+    if (coord.dtype() == dtype<double>)
+      apply_to_lists<double, double, double>(op, data, coord, edges, weights);
+    else
+      apply_to_lists<double, float, double>(op, data, coord, edges, weights);
+  } else {
+    if (coord.dtype() == dtype<double>)
+      apply_to_lists<float, double, float>(op, data, coord, edges, weights);
+    else
+      apply_to_lists<float, float, float>(op, data, coord, edges, weights);
+  }
+  data.setUnit(unit);
+}
+} // namespace sparse_dense_op_inplace_detail
+
 DataArray &DataArray::operator+=(const DataArrayConstView &other) {
   expect::coordsAndLabelsAreSuperset(*this, other);
   union_or_in_place(masks(), other.masks());
@@ -179,9 +351,11 @@ DataArray &sparse_dense_op_inplace(Op op, DataArray &a,
     // slice to exclude this from comparison.
     expect::coordsAndLabelsAreSuperset(a, b.slice({dim, 0}));
     union_or_in_place(a.masks(), b.masks());
-    if (a.hasData()) {
-      // Note the inefficiency here: Always creating temporary sparse data.
-      // Could easily avoided, but requires significant code duplication.
+    namespace fused = sparse_dense_op_inplace_detail;
+    if (a.hasData() && fused::is_supported(a.data(), a.coords()[dim],
+                                           b.coords()[dim], b.data())) {
+      fused::apply(op, a.data(), a.coords()[dim], b.coords()[dim], b.data());
+    } else if (a.hasData()) {
       a.data() *= sparse_dense_op_impl<0>(op, a.coords()[dim], b.coords()[dim],
                                           b.data());
     } else {
@@ -117,6 +117,69 @@ Dataset concatenate(const DatasetConstView &a, const DatasetConstView &b,
   return result;
 }
 
+namespace {
+template <class T>
+auto gather_map(const T &map, const Dim dim,
+                const std::vector<IndexRange> &ranges, const scipp::index size,
+                const scipp::index extent) {
+  std::map<typename T::key_type, Variable> out;
+  for (const auto &[key, var] : map) {
+    if (!var.dims().denseContains(dim))
+      out.emplace(key, copy(var));
+    else if (var.dims()[dim] == extent)
+      out.emplace(key, gather(var, dim, ranges, size));
+    else
+      out.emplace(key, gather_edges(var, dim, ranges, size));
+  }
+  return out;
+}
+
+DataArray gather(const DataArrayConstView &a, const Dim dim,
+                 const std::vector<IndexRange> &ranges, const scipp::index size,
+                 const bool withAttrs) {
+  const auto extent = a.dims()[dim];
+  return DataArray(
+      a.hasData() ? gather(a.data(), dim, ranges, size)
+                  : std::optional<Variable>(),
+      gather_map(a.coords(), dim, ranges, size, extent),
+      gather_map(a.labels(), dim, ranges, size, extent),
+      gather_map(a.masks(), dim, ranges, size, extent),
+      withAttrs ? gather_map(a.attrs(), dim, ranges, size, extent)
+                : std::map<std::string, Variable>(),
+      a.name());
+}
+} // namespace
+
+/// Return a DataArray containing the slices of `a` along `dim` given by
+/// `indices`, in the order given by `indices`.
+///
+/// Coords, labels, masks, and attributes depending on `dim` are gathered,
+/// everything else is copied.
+DataArray gather(const DataArrayConstView &a, const Dim dim,
+                 const std::vector<scipp::index> &indices) {
+  return gather(a, dim, contiguous_ranges(indices), scipp::size(indices), true);
+}
+
+/// Return a Dataset containing the slices of `d` along `dim` given by
+/// `indices`, in the order given by `indices`.
+///
+/// As when slicing a dataset, items that do not depend on `dim` are dropped.
+Dataset gather(const DatasetConstView &d, const Dim dim,
+               const std::vector<scipp::index> &indices) {
+  const auto ranges = contiguous_ranges(indices);
+  const auto size = scipp::size(indices);
+  const auto extent = d.dimensions().at(dim);
+  Dataset result(std::map<std::string, Variable>(),
+                 gather_map(d.coords(), dim, ranges, size, extent),
+                 gather_map(d.labels(), dim, ranges, size, extent),
+                 gather_map(d.masks(), dim, ranges, size, extent),
+                 gather_map(d.attrs(), dim, ranges, size, extent));
+  for (const auto &item : d)
+    if (item.dims().contains(dim))
+      result.setData(item.name(), gather(item, dim, ranges, size, false));
+  return result;
+}
+
 DataArray flatten(const DataArrayConstView &a, const Dim dim) {
   return apply_or_copy_dim(a, [](auto &&... _) { return flatten(_...); }, dim,
                            a.masks());
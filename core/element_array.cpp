@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "scipp/core/element_array.h"
+#include "scipp/core/memory_pool.h"
+
+namespace scipp::core {
+
+namespace {
+constexpr size_t huge_page_size = size_t(2) << 20;
+
+StorageAllocator from_environment() {
+  const char *env = std::getenv("SCIPP_STORAGE_ALLOCATOR");
+  if (env == nullptr || std::strlen(env) == 0)
+    return StorageAllocator::Default;
+  try {
+    return to_storage_allocator(env);
+  } catch (const std::invalid_argument &) {
+    // Not a good place for throwing, this is called on first use.
+    return StorageAllocator::Default;
+  }
+}
+
+std::atomic<StorageAllocator> &default_allocator() {
+  static std::atomic<StorageAllocator> allocator{from_environment()};
+  return allocator;
+}
+
+void *aligned_alloc(const size_t align, const size_t size) {
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, align, size) != 0)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void aligned_free(void *ptr) noexcept {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+} // namespace
+
+StorageAllocator to_storage_allocator(const std::string &name) {
+  if (name == "default")
+    return StorageAllocator::Default;
+  if (name == "aligned")
+    return StorageAllocator::Aligned;
+  if (name == "pool")
+    return StorageAllocator::Pool;
+  if (name == "huge_pages")
+    return StorageAllocator::HugePages;
+  if (name == "first_touch")
+    return StorageAllocator::FirstTouch;
+  throw std::invalid_argument("Unknown storage allocator `" + name +
+                              "`, expected one of default, aligned, pool, "
+                              "huge_pages, or first_touch.");
+}
+
+/// Return the allocator used for new variables.
+StorageAllocator default_storage_allocator() noexcept {
+  return default_allocator().load(std::memory_order_relaxed);
+}
+
+/// Set the allocator used for new variables and return the previous one.
+///
+/// The initial value is taken from the environment variable
+/// SCIPP_STORAGE_ALLOCATOR, if set. Existing arrays, and copies thereof,
+/// continue to use the allocator they were created with. External storage
+/// cannot be allocated, `StorageAllocator::External` selects the default.
+StorageAllocator
+set_default_storage_allocator(const StorageAllocator allocator) noexcept {
+  return default_allocator().exchange(allocator == StorageAllocator::External
+                                          ? StorageAllocator::Default
+                                          : allocator);
+}
+
+namespace detail {
+void *allocate_storage(const StorageAllocator allocator, const size_t size,
+                       const size_t align) {
+  switch (allocator) {
+  case StorageAllocator::Aligned:
+    return aligned_alloc(std::max(align, storage_alignment), size);
+  case StorageAllocator::Pool:
+    if (align > MemoryPool::alignment)
+      throw std::bad_alloc();
+    return instance().allocate(size);
+  case StorageAllocator::HugePages: {
+    if (size < huge_page_size)
+      return aligned_alloc(std::max(align, storage_alignment), size);
+    // Round up so the last partial page can also be backed by a huge page.
+    const auto bytes =
+        (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+    void *ptr = aligned_alloc(huge_page_size, bytes);
+#ifdef MADV_HUGEPAGE
+    // Only advisory, failure is not an error.
+    static_cast<void>(madvise(ptr, bytes, MADV_HUGEPAGE));
+#endif
+    return ptr;
+  }
+  case StorageAllocator::FirstTouch:
+    // Large allocations obtain fresh pages from the operating system so the
+    // pages are placed on first write.
+    return aligned_alloc(std::max(align, storage_alignment), size);
+  default:
+    return ::operator new(size, std::align_val_t(align));
+  }
+}
+
+void deallocate_storage(const StorageAllocator allocator, void *ptr,
+                        const size_t align) noexcept {
+  switch (allocator) {
+  case StorageAllocator::Pool:
+    return instance().deallocate(ptr);
+  case StorageAllocator::Aligned:
+  case StorageAllocator::HugePages:
+  case StorageAllocator::FirstTouch:
+    return aligned_free(ptr);
+  default:
+    return ::operator delete(ptr, std::align_val_t(align));
+  }
+}
+} // namespace detail
+
+} // namespace scipp::core
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "scipp/core/event_stream.h"
+#include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
+
+namespace scipp::core {
+
+namespace {
+/// Events of a batch grouped by event list, computed with a counting sort.
+struct Grouping {
+  Grouping(const std::vector<scipp::index> &rows, const scipp::index nrow)
+      : offsets(nrow + 1), order(rows.size()) {
+    for (const auto row : rows)
+      ++offsets[row + 1];
+    for (scipp::index row = 0; row < nrow; ++row) {
+      if (offsets[row + 1] != 0)
+        touched.push_back(row);
+      offsets[row + 1] += offsets[row];
+    }
+    auto next = offsets;
+    for (scipp::index i = 0; i < scipp::size(rows); ++i)
+      order[next[rows[i]]++] = i;
+  }
+
+  scipp::index count(const scipp::index row) const {
+    return offsets[row + 1] - offsets[row];
+  }
+
+  /// Events of list `row` are given by `order` in the range
+  /// [offsets[row], offsets[row + 1]).
+  std::vector<scipp::index> offsets;
+  std::vector<scipp::index> order;
+  /// Event lists with at least one new event.
+  std::vector<scipp::index> touched;
+};
+
+/// Append events in `flat` to the event lists in `lists`, in parallel over the
+/// event lists. Every list is modified by a single thread.
+template <class Lists, class T>
+void append_to_lists(const Lists &lists, const scipp::span<const T> &flat,
+                     const Grouping &grouping) {
+  const auto &touched = grouping.touched;
+  parallel::parallel_for(
+      parallel::blocked_range(0, scipp::size(touched)),
+      [&](const auto &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          const auto row = touched[i];
+          auto &list = lists[row];
+          // Same rule as in sparse::reserve, smaller reserves would prevent
+          // the geometric growth of the container.
+          const auto capacity = scipp::size(list) + grouping.count(row);
+          if (capacity > 2 * scipp::size(list))
+            list.reserve(capacity);
+          for (auto j = grouping.offsets[row]; j < grouping.offsets[row + 1];
+               ++j)
+            list.push_back(flat[grouping.order[j]]);
+        }
+      });
+}
+
+template <class T> struct AppendEvents {
+  static void apply(const VariableView &sparse, const VariableConstView &flat,
+                    const Grouping &grouping) {
+    // Gather from a contiguous copy since the batch may be a slice.
+    const Variable batch(flat);
+    append_to_lists(sparse.sparseValues<T>(), batch.values<T>(), grouping);
+    if (sparse.hasVariances())
+      append_to_lists(sparse.sparseVariances<T>(), batch.variances<T>(),
+                      grouping);
+  }
+};
+
+using EventTypes = CallDType<double, float, int64_t, int32_t>;
+
+void expect_compatible(const VariableConstView &sparse,
+                       const VariableConstView &flat) {
+  expect::equals(flat.unit(), sparse.unit());
+  if (flat.dtype() != sparse.dtype())
+    throw except::TypeError("Events in batch must have the same dtype as the "
+                            "existing events.");
+  const auto type = sparse.dtype();
+  if (type != dtype<double> && type != dtype<float> &&
+      type != dtype<int64_t> && type != dtype<int32_t>)
+    throw except::TypeError("Appending is not supported for events of dtype " +
+                            to_string(type) + '.');
+  if (flat.hasVariances() != sparse.hasVariances())
+    throw except::VariancesError("Events in batch must have variances if and "
+                                 "only if the existing events have "
+                                 "variances.");
+}
+
+std::vector<scipp::index> get_rows(const VariableConstView &index,
+                                   const scipp::index nrow) {
+  std::vector<scipp::index> rows(index.dims().volume());
+  if (index.dtype() == dtype<int64_t>)
+    std::copy(index.values<int64_t>().begin(), index.values<int64_t>().end(),
+              rows.begin());
+  else if (index.dtype() == dtype<int32_t>)
+    std::copy(index.values<int32_t>().begin(), index.values<int32_t>().end(),
+              rows.begin());
+  else
+    throw except::TypeError("Expected index with dtype int64 or int32.");
+  if (std::any_of(rows.begin(), rows.end(),
+                  [nrow](const auto row) { return row < 0 || row >= nrow; }))
+    throw except::SizeError("Index of event is out of range.");
+  return rows;
+}
+} // namespace
+
+namespace sparse {
+void append(const DataArrayView &events, const VariableConstView &index,
+            const DataArrayConstView &batch) {
+  if (!events.dims().sparse())
+    throw except::DimensionError("Expected sparse data.");
+  if (index.dims().ndim() != 1 || batch.dims().ndim() != 1 ||
+      batch.dims().sparse() || batch.dims().inner() != events.dims().inner())
+    throw except::DimensionError(
+        "Expected 1-dimensional index, and batch of events along the sparse "
+        "dimension of the events.");
+  if (index.dims().volume() != batch.dims().volume())
+    throw except::SizeError("Index and batch must have the same size.");
+  if (events.hasData() && !batch.hasData())
+    throw except::SparseDataError("Expected batch with data, since the "
+                                  "existing events have data.");
+
+  // Pairs of event lists and new events. Everything is validated before
+  // appending, such that a failing call leaves `events` unchanged.
+  std::vector<std::pair<VariableView, VariableConstView>> targets;
+  for (const auto &[dim, coord] : events.coords()) {
+    if (!coord.dims().sparse())
+      continue;
+    if (!batch.coords().contains(dim))
+      throw except::NotFoundError("Batch does not contain the coordinate " +
+                                  to_string(dim) + " of the events.");
+    targets.emplace_back(coord, batch.coords()[dim]);
+  }
+  for (const auto &[name, labels] : events.labels()) {
+    if (!labels.dims().sparse())
+      continue;
+    if (!batch.labels().contains(name))
+      throw except::NotFoundError("Batch does not contain the labels `" +
+                                  name + "` of the events.");
+    targets.emplace_back(labels, batch.labels()[name]);
+  }
+  if (events.hasData())
+    targets.emplace_back(events.data(), batch.data());
+  for (const auto &[sparse, flat] : targets)
+    expect_compatible(sparse, flat);
+
+  const auto nrow = denseDims(events.dims()).volume();
+  const Grouping grouping(get_rows(index, nrow), nrow);
+  for (const auto &[sparse, flat] : targets)
+    EventTypes::apply<AppendEvents>(sparse.dtype(), sparse, flat, grouping);
+}
+} // namespace sparse
+
+EventStream::EventStream(DataArray events) : m_events(std::move(events)) {
+  if (!m_events.dims().sparse())
+    throw except::DimensionError("EventStream requires sparse data.");
+}
+
+void EventStream::append(const VariableConstView &index,
+                         const DataArrayConstView &batch) {
+  sparse::append(m_events, index, batch);
+  // Histograms are updated from the new events only. Their bin edges and
+  // units have been validated against the events in `addHistogram`.
+  const auto coord = batch.coords()[m_events.dims().sparseDim()];
+  for (auto &item : m_histograms)
+    item.second.add(index, coord,
+                    m_events.hasData()
+                        ? std::optional<VariableConstView>(batch.data())
+                        : std::nullopt);
+}
+
+void EventStream::addHistogram(const std::string &name,
+                               const VariableConstView &binEdges) {
+  HistogramAccumulator histogram(denseDims(m_events.dims()), binEdges);
+  histogram.add(m_events);
+  m_histograms.insert_or_assign(name, std::move(histogram));
+}
+
+const DataArray &EventStream::histogram(const std::string &name) const {
+  if (const auto it = m_histograms.find(name); it != m_histograms.end())
+    return it->second.result();
+  throw except::NotFoundError("EventStream has no histogram `" + name + "`.");
+}
+
+} // namespace scipp::core
@@ -2,7 +2,11 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <numeric>
+#include <type_traits>
 
 #include "scipp/core/except.h"
 #include "scipp/core/groupby.h"
@@ -10,8 +14,10 @@
 #include "scipp/core/indexed_slice_view.h"
 #include "scipp/core/parallel.h"
 #include "scipp/core/tag_util.h"
+#include "scipp/core/transform.h"
 
 #include "dataset_operations_common.h"
+#include "histogram_lookup.h"
 #include "variable_operations_common.h"
 
 namespace scipp::core {
@@ -29,25 +35,190 @@ T GroupBy<T>::makeReductionOutput(const Dim reductionDim) const {
   return out;
 }
 
+namespace groupby_detail {
+/// Estimated cost of processing a slice, in addition to its elements.
+constexpr scipp::index slice_cost = 16;
+/// Groups are split into parts if their cost exceeds this fraction of the
+/// total cost of all groups.
+constexpr scipp::index max_task_fraction = 64;
+/// Minimum cost of a part of a split group.
+constexpr scipp::index min_task_cost = 1 << 14;
+
+/// Add number of events in each row of `reductionDim` to `events[row + 1]`.
+static void add_event_counts(std::vector<scipp::index> &events,
+                             const VariableConstView &var,
+                             const Dim reductionDim) {
+  auto counts = sparse::counts(var);
+  const auto dims = counts.dims();
+  for (const auto dim : dims.labels())
+    if (dim != reductionDim)
+      counts = core::sum(counts, dim);
+  auto it = events.begin() + 1;
+  for (const auto count : counts.values<scipp::index>())
+    *it++ += count;
+}
+
+/// Return the estimated cost of processing each group.
+///
+/// The cost of a group is given by the number of elements in its rows, i.e.,
+/// slices of `reductionDim`, and for sparse data the number of events in
+/// these rows.
+template <class T>
+std::vector<scipp::index>
+group_cost(const T &data, const std::vector<GroupByGrouping::group> &groups,
+           const Dim reductionDim) {
+  scipp::index row_size = 0;
+  std::vector<scipp::index> events; // cumulative events before each row
+  const auto add_item = [&](const auto &item) {
+    const auto &dims = item.dims();
+    if (!dims.denseContains(reductionDim) || dims[reductionDim] == 0)
+      return;
+    row_size += dims.volume() / dims[reductionDim];
+    if (dims.sparse()) {
+      events.resize(dims[reductionDim] + 1);
+      add_event_counts(events, item.coords()[dims.sparseDim()], reductionDim);
+    }
+  };
+  if constexpr (std::is_same_v<T, DatasetConstView>) {
+    for (const auto &item : data)
+      add_item(item);
+  } else {
+    add_item(data);
+  }
+  std::partial_sum(events.begin(), events.end(), events.begin());
+  std::vector<scipp::index> cost(groups.size());
+  for (scipp::index group = 0; group < scipp::size(groups); ++group)
+    for (const auto &slice : groups[group]) {
+      cost[group] += slice_cost + (slice.end() - slice.begin()) * row_size;
+      if (!events.empty())
+        cost[group] += events[slice.end()] - events[slice.begin()];
+    }
+  return cost;
+}
+
+/// Unit of work of a reduction: Part [begin, end) of the split dimension of a
+/// group. If the output cannot be split `end` is -1.
+struct Task {
+  scipp::index group;
+  scipp::index begin;
+  scipp::index end;
+};
+
+/// Return tasks in order of decreasing cost.
+///
+/// Scheduling expensive groups first and using a grainsize of 1 lets TBB's
+/// work stealing balance the load also if group sizes vary by orders of
+/// magnitude. Groups that would still dominate the runtime are split into
+/// several tasks along the output dimension with extent `splitExtent`.
+static std::vector<Task> schedule(const std::vector<scipp::index> &cost,
+                                  const scipp::index splitExtent) {
+  std::vector<scipp::index> order(cost.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&cost](const auto a, const auto b) {
+                     return cost[a] > cost[b];
+                   });
+  const auto total = std::accumulate(cost.begin(), cost.end(), scipp::index(0));
+  const auto max_cost = std::max(scipp::index(1), total / max_task_fraction);
+  std::vector<Task> tasks;
+  tasks.reserve(order.size());
+  for (const auto group : order) {
+    const auto parts =
+        splitExtent < 0 ? 1
+                        : std::min({splitExtent,
+                                    (cost[group] + max_cost - 1) / max_cost,
+                                    cost[group] / min_task_cost});
+    if (parts <= 1) {
+      tasks.push_back({group, 0, -1});
+      continue;
+    }
+    for (scipp::index part = 0; part < parts; ++part)
+      tasks.push_back({group, part * splitExtent / parts,
+                       (part + 1) * splitExtent / parts});
+  }
+  return tasks;
+}
+
+/// Return the outermost dimension of `dims` that the output of a reduction
+/// can be split along, or Dim::Invalid. The inner dimension is never split
+/// since this would result in non-contiguous memory access.
+static Dim split_dim(const Dimensions &dims, const Dim groupDim) {
+  for (const auto dim : dims.labels())
+    if (dim != groupDim && dim != dims.inner() && dims[dim] > 1)
+      return dim;
+  return Dim::Invalid;
+}
+
+/// Return the dimension and its extent that the output of a reduction can be
+/// split along, or Dim::Invalid and -1.
+template <class T>
+std::pair<Dim, scipp::index> split_dim(const T &out, const Dim groupDim) {
+  if constexpr (std::is_same_v<T, Dataset>) {
+    for (const auto &item : out)
+      if (const auto dim = split_dim(item.dims(), groupDim);
+          dim != Dim::Invalid)
+        return {dim, item.dims()[dim]};
+  } else {
+    if (const auto dim = split_dim(out.dims(), groupDim); dim != Dim::Invalid)
+      return {dim, out.dims()[dim]};
+  }
+  return {Dim::Invalid, -1};
+}
+
+/// Apply `op` to the part of `out` and `in` selected by `task`.
+template <class Op, class Out, class In>
+void apply_task(Op &op, const Out &out, const In &in,
+                const GroupByGrouping::group &group, const Dim reductionDim,
+                const Variable &mask, const Dim splitDim, const Task &task) {
+  if (task.end < 0)
+    return op(out, in, group, reductionDim, mask);
+  if (!out.dims().contains(splitDim)) {
+    // Item does not depend on split dimension, process only once.
+    if (task.begin == 0)
+      op(out, in, group, reductionDim, mask);
+    return;
+  }
+  const Slice part(splitDim, task.begin, task.end);
+  if (mask.dims().contains(splitDim))
+    op(out.slice(part), in.slice(part), group, reductionDim,
+       Variable(mask.slice(part)));
+  else
+    op(out.slice(part), in.slice(part), group, reductionDim, mask);
+}
+} // namespace groupby_detail
+
 template <class T>
 template <class Op>
 T GroupBy<T>::reduce(Op op, const Dim reductionDim) const {
-  auto out = makeReductionOutput(reductionDim);
+  return reduce(op, reductionDim, makeReductionOutput(reductionDim));
+}
+
+template <class T>
+template <class Op>
+T GroupBy<T>::reduce(Op op, const Dim reductionDim, T out) const {
   const auto mask = ~masks_merge_if_contains(m_data.masks(), reductionDim);
+  const auto [splitDim, splitExtent] = groupby_detail::split_dim(out, dim());
+  const auto tasks = groupby_detail::schedule(
+      groupby_detail::group_cost(m_data, groups(), reductionDim), splitExtent);
   // Apply to each group, storing result in output slice
-  const auto process_groups = [&](const auto &range) {
-    for (scipp::index group = range.begin(); group != range.end(); ++group) {
-      const auto out_slice = out.slice({dim(), group});
+  const auto process_tasks = [&](const auto &range) {
+    for (auto i = range.begin(); i != range.end(); ++i) {
+      const auto &task = tasks[i];
+      const auto &group = groups()[task.group];
+      const auto out_slice = out.slice({dim(), task.group});
       if constexpr (std::is_same_v<T, Dataset>) {
         for (const auto &item : m_data) {
-          op(out_slice[item.name()], item, groups()[group], reductionDim, mask);
+          groupby_detail::apply_task(op, out_slice[item.name()], item, group,
+                                     reductionDim, mask, splitDim, task);
         }
       } else {
-        op(out_slice, m_data, groups()[group], reductionDim, mask);
+        groupby_detail::apply_task(op, out_slice, m_data, group, reductionDim,
+                                   mask, splitDim, task);
       }
     }
   };
-  parallel::parallel_for(parallel::blocked_range(0, size()), process_groups);
+  parallel::parallel_for(parallel::blocked_range(0, scipp::size(tasks), 1),
+                         process_tasks);
   return out;
 }
 
@@ -79,12 +250,45 @@ static constexpr auto sum = [](const DataArrayView &out,
   for (const auto &slice : group) {
     const auto data_slice = data_container.slice(slice);
     if (mask.dims().contains(reductionDim))
-      sum_impl(out.data(), data_slice.data() * mask.slice(slice));
+      sum_impl(out.data(), data_slice.data(), mask.slice(slice));
     else
       sum_impl(out.data(), data_slice.data());
   }
 };
 
+/// Sum and count unmasked rows in a single pass over the group, then normalize
+/// the (still cached) output slice in-place.
+static constexpr auto mean = [](const DataArrayView &out,
+                                const auto &data_container,
+                                const GroupByGrouping::group &group,
+                                const Dim reductionDim, const Variable &mask) {
+  const bool masked = mask.dims().contains(reductionDim);
+  if (masked && mask.dims().ndim() != 1)
+    throw except::DimensionError(
+        "GroupBy::mean does not support multi-dimensional masks yet.");
+  scipp::index count = 0;
+  for (const auto &slice : group) {
+    const auto data_slice = data_container.slice(slice);
+    if (masked) {
+      const auto mask_slice = mask.slice(slice);
+      sum_impl(out.data(), data_slice.data(), mask_slice);
+      const auto valid = mask_slice.values<bool>();
+      count += std::count(valid.begin(), valid.end(), true);
+    } else {
+      sum_impl(out.data(), data_slice.data());
+      count += slice.end() - slice.begin();
+    }
+  }
+  // Empty groups yield NaN.
+  const double scale = 1.0 / static_cast<double>(count);
+  transform_in_place<double, float>(
+      out.data(), overloaded{[](units::Unit &) {},
+                             [scale](auto &x) {
+                               x *= static_cast<detail::element_type_t<
+                                   std::decay_t<decltype(x)>>>(scale);
+                             }});
+};
+
 template <void (*Func)(const VariableView &, const VariableConstView &)>
 static constexpr auto reduce_idempotent =
     [](const DataArrayView &out, const auto &data_container,
@@ -139,42 +343,19 @@ template <class T> T GroupBy<T>::min(const Dim reductionDim) const {
 
 /// Apply mean to groups and return combined data.
 template <class T> T GroupBy<T>::mean(const Dim reductionDim) const {
-  // 1. Sum into output slices
-  auto out = sum(reductionDim);
-
-  // 2. Compute number of slices N contributing to each out slice
-  auto scale = makeVariable<double>(Dims{dim()}, Shape{size()});
-  const auto scaleT = scale.template values<double>();
-  const auto mask = masks_merge_if_contains(m_data.masks(), reductionDim);
-  for (scipp::index group = 0; group < size(); ++group)
-    for (const auto &slice : groups()[group]) {
-      // N contributing to each slice
-      scaleT[group] += slice.end() - slice.begin();
-      // N masks for each slice, that need to be subtracted
-      if (mask.dims().contains(reductionDim)) {
-        const auto masks_sum = core::sum(mask.slice(slice), reductionDim);
-        scaleT[group] -= masks_sum.template value<int64_t>();
-      }
-    }
-
-  scale = 1.0 / scale;
-
-  // 3. sum/N -> mean
+  auto out = makeReductionOutput(reductionDim);
   if constexpr (std::is_same_v<T, Dataset>) {
-    for (const auto &item : out) {
+    std::vector<std::string> names;
+    for (const auto &item : out)
       if (isInt(item.data().dtype()))
-        out.setData(item.name(), item.data() * scale);
-      else
-        item *= scale;
-    }
+        names.emplace_back(item.name());
+    for (const auto &name : names)
+      out.setData(name, astype(out[name].data(), dtype<double>));
   } else {
     if (isInt(out.data().dtype()))
-      out.setData(out.data() * scale);
-    else
-      out *= scale;
+      out.setData(astype(out.data(), dtype<double>));
   }
-
-  return out;
+  return reduce(groupby_detail::mean, reductionDim, std::move(out));
 }
 
 static void expectValidGroupbyKey(const VariableConstView &key) {
@@ -184,69 +365,246 @@ static void expectValidGroupbyKey(const VariableConstView &key) {
     throw except::VariancesError("Group-by key cannot have variances");
 }
 
-template <class T> struct MakeGroups {
-  static auto apply(const VariableConstView &key, const Dim targetDim) {
-    expectValidGroupbyKey(key);
-    const auto &values = key.values<T>();
+namespace groupby_detail {
+/// Hashing and comparison of group-by keys. Floating-point keys are treated
+/// such that 0.0 and -0.0 are equal and all NaN values form a single group,
+/// sorted after all other keys.
+template <class T> struct KeyTraits {
+  static size_t hash(const T &key) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (key == T{0})
+        return 0;
+      if (std::isnan(key))
+        return 1;
+    }
+    // Fibonacci hashing, std::hash is the identity for integers.
+    return std::hash<T>{}(key) * 0x9E3779B97F4A7C15ull;
+  }
+  static bool equal(const T &a, const T &b) noexcept {
+    if constexpr (std::is_floating_point_v<T>)
+      return a == b || (std::isnan(a) && std::isnan(b));
+    else
+      return a == b;
+  }
+  static bool less(const T &a, const T &b) noexcept {
+    if constexpr (std::is_floating_point_v<T>)
+      return std::isnan(b) ? !std::isnan(a) : a < b;
+    else
+      return a < b;
+  }
+};
+
+/// Open-addressing hash table assigning consecutive indices to distinct keys.
+///
+/// Only pointers to the keys are stored, i.e., keys must outlive the table.
+template <class T> class KeyTable {
+public:
+  /// Return the index of `key`, inserting it if not present.
+  scipp::index insert(const T &key) {
+    if (2 * (scipp::size(m_keys) + 1) > scipp::size(m_slots))
+      grow();
+    const auto slot = find_slot(key);
+    if (m_slots[slot] < 0) {
+      m_slots[slot] = scipp::size(m_keys);
+      m_keys.push_back(&key);
+    }
+    return m_slots[slot];
+  }
+  /// Return the index of `key`, which must be present.
+  scipp::index find(const T &key) const noexcept {
+    return m_slots[find_slot(key)];
+  }
+  /// Return pointers to keys in order of insertion.
+  const std::vector<const T *> &keys() const noexcept { return m_keys; }
+
+private:
+  size_t find_slot(const T &key) const noexcept {
+    const size_t mask = m_slots.size() - 1;
+    auto slot = (KeyTraits<T>::hash(key) >> m_shift) & mask;
+    while (m_slots[slot] >= 0 &&
+           !KeyTraits<T>::equal(*m_keys[m_slots[slot]], key))
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  void grow() {
+    const auto size = std::max(size_t(16), 2 * m_slots.size());
+    m_shift = 64 - static_cast<int32_t>(std::log2(size));
+    m_slots.assign(size, -1);
+    for (scipp::index i = 0; i < scipp::size(m_keys); ++i)
+      m_slots[find_slot(*m_keys[i])] = i;
+  }
+
+  // Use the high bits of the hash, which are well mixed.
+  int32_t m_shift{64};
+  std::vector<scipp::index> m_slots;
+  std::vector<const T *> m_keys;
+};
+
+/// Accessor for values of a 1-D variable (view), avoiding the overhead of
+/// ElementArrayView's iterator for the common case of contiguous data.
+template <class T> class Values1D {
+public:
+  explicit Values1D(const ElementArrayView<const T> &values)
+      : m_data(values.data()),
+        m_stride(values.size() > 1 ? &values[1] - &values[0] : 1) {}
+  const T &operator[](const scipp::index i) const noexcept {
+    return m_data[i * m_stride];
+  }
+
+private:
+  const T *m_data;
+  scipp::index m_stride;
+};
+
+/// Contiguous range of rows belonging to the same group.
+struct Run {
+  scipp::index begin;
+  scipp::index end;
+  scipp::index group;
+};
 
-    const auto dim = key.dims().inner();
-    std::map<T, GroupByGrouping::group> indices;
-    const auto end = values.end();
-    scipp::index i = 0;
-    for (auto it = values.begin(); it != end;) {
+/// Minimum number of rows per chunk for parallel construction of groups.
+constexpr scipp::index rows_per_chunk = 1 << 14;
+/// Maximum number of chunks for parallel construction of groups.
+constexpr scipp::index max_chunks = 64;
+
+/// Call `func(chunk, begin, end)` in parallel for chunks of rows in [0, size).
+template <class Func> scipp::index for_each_chunk(const scipp::index size,
+                                                  Func func) {
+  const auto nchunk = std::clamp((size + rows_per_chunk - 1) / rows_per_chunk,
+                                 scipp::index(1), max_chunks);
+  parallel::parallel_for(parallel::blocked_range(0, nchunk, 1),
+                         [&](const auto &range) {
+                           for (auto c = range.begin(); c != range.end(); ++c)
+                             func(c, c * size / nchunk,
+                                  (c + 1) * size / nchunk);
+                         });
+  return nchunk;
+}
+
+/// Append runs to their groups, in order, merging runs that are continued
+/// across chunk boundaries. Runs with negative group index are skipped.
+static auto combine_runs(const Dim dim,
+                         const std::vector<std::vector<Run>> &runs,
+                         const scipp::index ngroup) {
+  std::vector<scipp::index> count(ngroup);
+  for (const auto &chunk : runs)
+    for (const auto &run : chunk)
+      if (run.group >= 0)
+        ++count[run.group];
+  std::vector<GroupByGrouping::group> groups(ngroup);
+  for (scipp::index group = 0; group < ngroup; ++group)
+    groups[group].reserve(count[group]);
+  for (const auto &chunk : runs)
+    for (const auto &run : chunk) {
+      if (run.group < 0)
+        continue;
+      auto &group = groups[run.group];
       // Use contiguous (thick) slices if possible to avoid overhead of slice
       // handling in follow-up "apply" steps.
-      const auto begin = i;
-      const auto &value = *it;
-      while (it != end && *it == value) {
-        ++it;
-        ++i;
-      }
-      indices[value].emplace_back(dim, begin, i);
+      if (!group.empty() && group.back().end() == run.begin)
+        group.back() = Slice(dim, group.back().begin(), run.end);
+      else
+        group.emplace_back(dim, run.begin, run.end);
     }
+  return groups;
+}
+} // namespace groupby_detail
+
+/// Group rows by key using hash tables, built in parallel for chunks of rows
+/// and merged at the end. Keys are not copied, apart from the output keys.
+template <class T> struct MakeGroups {
+  static auto apply(const VariableConstView &key, const Dim targetDim) {
+    using namespace groupby_detail;
+    expectValidGroupbyKey(key);
+    const Values1D<T> values(key.values<T>());
+    const auto size = key.dims().volume();
+
+    std::vector<std::vector<Run>> runs(max_chunks);
+    std::vector<KeyTable<T>> tables(max_chunks);
+    const auto nchunk =
+        for_each_chunk(size, [&](const scipp::index chunk,
+                                 const scipp::index begin,
+                                 const scipp::index end) {
+          for (scipp::index i = begin; i < end;) {
+            const auto &value = values[i];
+            const auto run_begin = i;
+            while (i < end && KeyTraits<T>::equal(values[i], value))
+              ++i;
+            runs[chunk].push_back({run_begin, i, tables[chunk].insert(value)});
+          }
+        });
 
-    const Dimensions dims{targetDim, scipp::size(indices)};
+    // Merge tables, then map chunk-local key indices to sorted group indices.
+    KeyTable<T> table;
+    for (scipp::index chunk = 0; chunk < nchunk; ++chunk)
+      for (const auto *k : tables[chunk].keys())
+        table.insert(*k);
+    auto sorted = table.keys();
+    std::sort(sorted.begin(), sorted.end(), [](const T *a, const T *b) {
+      return KeyTraits<T>::less(*a, *b);
+    });
+    std::vector<scipp::index> group(sorted.size());
+    for (scipp::index i = 0; i < scipp::size(sorted); ++i)
+      group[table.find(*sorted[i])] = i;
+    parallel::parallel_for(
+        parallel::blocked_range(0, nchunk, 1), [&](const auto &range) {
+          for (auto chunk = range.begin(); chunk != range.end(); ++chunk) {
+            std::vector<scipp::index> to_group;
+            for (const auto *k : tables[chunk].keys())
+              to_group.push_back(group[table.find(*k)]);
+            for (auto &run : runs[chunk])
+              run.group = to_group[run.group];
+          }
+        });
+
+    const Dimensions dims{targetDim, scipp::size(sorted)};
     std::vector<T> keys;
-    std::vector<GroupByGrouping::group> groups;
-    for (auto &item : indices) {
-      keys.emplace_back(std::move(item.first));
-      groups.emplace_back(std::move(item.second));
-    }
+    keys.reserve(sorted.size());
+    for (const auto *k : sorted)
+      keys.emplace_back(*k);
     auto keys_ = makeVariable<T>(Dimensions{dims}, Values(std::move(keys)));
     keys_.setUnit(key.unit());
-    return GroupByGrouping{std::move(keys_), std::move(groups)};
+    return GroupByGrouping{
+        std::move(keys_),
+        combine_runs(key.dims().inner(), runs, scipp::size(sorted))};
   }
 };
 
+/// Group rows by the bin containing the key, in parallel for chunks of rows.
 template <class T> struct MakeBinGroups {
   static auto apply(const VariableConstView &key,
                     const VariableConstView &bins) {
+    using namespace groupby_detail;
     expectValidGroupbyKey(key);
     if (bins.dims().ndim() != 1)
       throw except::DimensionError("Group-by bins must be 1-dimensional");
     if (key.unit() != bins.unit())
       throw except::UnitError("Group-by key must have same unit as bins");
-    const auto &values = key.values<T>();
-    const auto &edges = bins.values<T>();
-    expect::histogram::sorted_edges(edges);
+    const Values1D<T> values(key.values<T>());
+    const histogram_detail::EdgeLookup<T> lookup(bins.values<T>());
+    const auto edges = lookup.edges();
 
-    const auto dim = key.dims().inner();
-    std::vector<GroupByGrouping::group> groups(edges.size() - 1);
-    for (scipp::index i = 0; i < scipp::size(values);) {
-      // Use contiguous (thick) slices if possible to avoid overhead of slice
-      // handling in follow-up "apply" steps.
-      const auto value = values[i];
-      const auto begin = i++;
-      auto right = std::upper_bound(edges.begin(), edges.end(), value);
-      if (right != edges.end() && right != edges.begin()) {
-        auto left = right - 1;
-        while (i < scipp::size(values) && (*left <= values[i]) &&
-               (values[i] < *right))
-          ++i;
-        groups[std::distance(edges.begin(), left)].emplace_back(dim, begin, i);
+    std::vector<std::vector<Run>> runs(max_chunks);
+    for_each_chunk(key.dims().volume(), [&](const scipp::index chunk,
+                                            const scipp::index begin,
+                                            const scipp::index end) {
+      for (scipp::index i = begin; i < end;) {
+        const auto run_begin = i;
+        const auto bin = lookup(values[i++]);
+        if (bin >= 0) {
+          const auto left = edges[bin];
+          const auto right = edges[bin + 1];
+          while (i < end && left <= values[i] && values[i] < right)
+            ++i;
+          runs[chunk].push_back({run_begin, i, bin});
+        }
       }
-    }
-    return GroupByGrouping{Variable(bins), std::move(groups)};
+    });
+    return GroupByGrouping{
+        Variable(bins),
+        combine_runs(key.dims().inner(), runs, scipp::size(edges) - 1)};
   }
 };
 
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SCIPP_HISTOGRAM_X86_SIMD
+// Conversion intrinsics in GCC's AVX-512 header trigger false positives.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+#include "histogram_linear.h"
+
+namespace scipp::core::histogram_detail {
+
+namespace {
+/// Number of events for which bin indices are computed in one go.
+constexpr scipp::index block_size = 256;
+/// Number of private sub-histograms. Consecutive events are added to
+/// different sub-histograms to avoid dependency chains on the same bin.
+constexpr scipp::index lanes = 4;
+
+/// Compute bin indices of `events`, using `nbin` for out-of-range events.
+///
+/// The arithmetic is done in the common type of coord and edges and in the
+/// same order as in the scalar version, so the result is identical for all
+/// implementations.
+template <class Coord, class T>
+using bin_index_kernel = void (*)(int32_t *, const Coord *, scipp::index, T,
+                                  T, T);
+
+template <class Coord, class T>
+void bin_index_scalar(int32_t *index, const Coord *events,
+                      const scipp::index size, const T offset, const T nbin,
+                      const T scale) {
+  for (scipp::index i = 0; i < size; ++i) {
+    const T bin = (events[i] - offset) * scale;
+    index[i] = static_cast<int32_t>((bin >= 0 && bin < nbin) ? bin : nbin);
+  }
+}
+
+#ifdef SCIPP_HISTOGRAM_X86_SIMD
+template <class Coord, class T>
+__attribute__((target("avx2"))) void
+bin_index_avx2(int32_t *index, const Coord *events, const scipp::index size,
+               const T offset, const T nbin, const T scale) {
+  scipp::index i = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    const auto offset_ = _mm256_set1_ps(offset);
+    const auto nbin_ = _mm256_set1_ps(nbin);
+    const auto scale_ = _mm256_set1_ps(scale);
+    const auto zero = _mm256_setzero_ps();
+    for (; i + 8 <= size; i += 8) {
+      const auto x = _mm256_loadu_ps(events + i);
+      const auto bin = _mm256_mul_ps(_mm256_sub_ps(x, offset_), scale_);
+      const auto in_range = _mm256_and_ps(_mm256_cmp_ps(bin, zero, _CMP_GE_OQ),
+                                          _mm256_cmp_ps(bin, nbin_, _CMP_LT_OQ));
+      const auto b = _mm256_blendv_ps(nbin_, bin, in_range);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(index + i),
+                          _mm256_cvttps_epi32(b));
+    }
+  } else {
+    const auto offset_ = _mm256_set1_pd(offset);
+    const auto nbin_ = _mm256_set1_pd(nbin);
+    const auto scale_ = _mm256_set1_pd(scale);
+    const auto zero = _mm256_setzero_pd();
+    for (; i + 4 <= size; i += 4) {
+      __m256d x;
+      if constexpr (std::is_same_v<Coord, float>)
+        x = _mm256_cvtps_pd(_mm_loadu_ps(events + i));
+      else
+        x = _mm256_loadu_pd(events + i);
+      const auto bin = _mm256_mul_pd(_mm256_sub_pd(x, offset_), scale_);
+      const auto in_range = _mm256_and_pd(_mm256_cmp_pd(bin, zero, _CMP_GE_OQ),
+                                          _mm256_cmp_pd(bin, nbin_, _CMP_LT_OQ));
+      const auto b = _mm256_blendv_pd(nbin_, bin, in_range);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(index + i),
+                       _mm256_cvttpd_epi32(b));
+    }
+  }
+  bin_index_scalar(index + i, events + i, size - i, offset, nbin, scale);
+}
+
+template <class Coord, class T>
+__attribute__((target("avx512f"))) void
+bin_index_avx512(int32_t *index, const Coord *events, const scipp::index size,
+                 const T offset, const T nbin, const T scale) {
+  scipp::index i = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    const auto offset_ = _mm512_set1_ps(offset);
+    const auto nbin_ = _mm512_set1_ps(nbin);
+    const auto scale_ = _mm512_set1_ps(scale);
+    const auto zero = _mm512_setzero_ps();
+    for (; i + 16 <= size; i += 16) {
+      const auto x = _mm512_loadu_ps(events + i);
+      const auto bin = _mm512_mul_ps(_mm512_sub_ps(x, offset_), scale_);
+      const auto in_range = _mm512_cmp_ps_mask(bin, zero, _CMP_GE_OQ) &
+                            _mm512_cmp_ps_mask(bin, nbin_, _CMP_LT_OQ);
+      const auto b = _mm512_mask_blend_ps(in_range, nbin_, bin);
+      _mm512_storeu_si512(index + i, _mm512_cvttps_epi32(b));
+    }
+  } else {
+    const auto offset_ = _mm512_set1_pd(offset);
+    const auto nbin_ = _mm512_set1_pd(nbin);
+    const auto scale_ = _mm512_set1_pd(scale);
+    const auto zero = _mm512_setzero_pd();
+    for (; i + 8 <= size; i += 8) {
+      __m512d x;
+      if constexpr (std::is_same_v<Coord, float>)
+        x = _mm512_cvtps_pd(_mm256_loadu_ps(events + i));
+      else
+        x = _mm512_loadu_pd(events + i);
+      const auto bin = _mm512_mul_pd(_mm512_sub_pd(x, offset_), scale_);
+      const auto in_range = _mm512_cmp_pd_mask(bin, zero, _CMP_GE_OQ) &
+                            _mm512_cmp_pd_mask(bin, nbin_, _CMP_LT_OQ);
+      const auto b = _mm512_mask_blend_pd(in_range, nbin_, bin);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(index + i),
+                          _mm512_cvttpd_epi32(b));
+    }
+  }
+  bin_index_scalar(index + i, events + i, size - i, offset, nbin, scale);
+}
+#endif
+
+template <class Coord, class T> bin_index_kernel<Coord, T> select_kernel() {
+#ifdef SCIPP_HISTOGRAM_X86_SIMD
+  if (__builtin_cpu_supports("avx512f"))
+    return bin_index_avx512<Coord, T>;
+  if (__builtin_cpu_supports("avx2"))
+    return bin_index_avx2<Coord, T>;
+#endif
+  return bin_index_scalar<Coord, T>;
+}
+
+template <class Coord, class T> bin_index_kernel<Coord, T> kernel() {
+  static const auto k = select_kernel<Coord, T>();
+  return k;
+}
+
+/// Call `add(event, bin, lane)` for all events in range.
+template <class Coord, class Edge, class Add>
+void for_each_bin(const scipp::span<const Coord> &events,
+                  const std::array<Edge, 3> &params, Add add) {
+  using T = std::common_type_t<Coord, Edge>;
+  const auto [offset, nbin, scale] = params;
+  const auto compute = kernel<Coord, T>();
+  alignas(64) int32_t index[block_size];
+  const auto size = scipp::size(events);
+  for (scipp::index begin = 0; begin < size; begin += block_size) {
+    const auto n = std::min(block_size, size - begin);
+    compute(index, events.data() + begin, n, offset, nbin, scale);
+    scipp::index i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      static_assert(lanes == 4);
+      add(begin + i, index[i], 0);
+      add(begin + i + 1, index[i + 1], 1);
+      add(begin + i + 2, index[i + 2], 2);
+      add(begin + i + 3, index[i + 3], 3);
+    }
+    for (; i < n; ++i)
+      add(begin + i, index[i], i % lanes);
+  }
+}
+
+/// Return true if private sub-histograms are worth the cost of clearing and
+/// combining them.
+bool use_lanes(const scipp::index events, const scipp::index nbin) {
+  return events >= 4 * lanes * (nbin + 1);
+}
+
+/// Scratch buffer for sub-histograms with an extra bin for out-of-range events.
+std::vector<double> &scratch(const scipp::index size) {
+  thread_local std::vector<double> buffer;
+  buffer.assign(size, 0.0);
+  return buffer;
+}
+
+template <class Edge> bool index_fits(const std::array<Edge, 3> &params) {
+  return params[1] < static_cast<Edge>(std::numeric_limits<int32_t>::max());
+}
+
+template <class Coord, class Edge>
+void histogram_scalar(const scipp::span<double> &out,
+                      const scipp::span<const Coord> &events,
+                      const std::array<Edge, 3> &params) {
+  const auto [offset, nbin, scale] = params;
+  for (const auto &e : events) {
+    const double bin = (e - offset) * scale;
+    if (bin >= 0.0 && bin < nbin)
+      ++out[static_cast<scipp::index>(bin)];
+  }
+}
+} // namespace
+
+template <class Coord, class Edge>
+void histogram_linear(const scipp::span<double> &out,
+                      const scipp::span<const Coord> &events,
+                      const std::array<Edge, 3> &params) {
+  if (!index_fits(params))
+    return histogram_scalar(out, events, params);
+  const auto nbin = scipp::size(out);
+  if (!use_lanes(scipp::size(events), nbin)) {
+    for_each_bin(events, params,
+                 [&](scipp::index, const int32_t bin, scipp::index) {
+                   if (bin < nbin)
+                     ++out[bin];
+                 });
+    return;
+  }
+  const auto stride = nbin + 1;
+  auto &sub = scratch(lanes * stride);
+  for_each_bin(events, params,
+               [&](scipp::index, const int32_t bin, const scipp::index lane) {
+                 ++sub[lane * stride + bin];
+               });
+  for (scipp::index lane = 0; lane < lanes; ++lane)
+    for (scipp::index bin = 0; bin < nbin; ++bin)
+      out[bin] += sub[lane * stride + bin];
+}
+
+template <class Coord, class Weight, class Edge>
+void histogram_linear(const scipp::span<double> &values,
+                      const scipp::span<double> &variances,
+                      const scipp::span<const Coord> &events,
+                      const scipp::span<const Weight> &weights,
+                      const scipp::span<const Weight> &weight_variances,
+                      const std::array<Edge, 3> &params) {
+  if (!index_fits(params)) {
+    const auto [offset, nbin, scale] = params;
+    for (scipp::index i = 0; i < scipp::size(events); ++i) {
+      const double bin = (events[i] - offset) * scale;
+      if (bin >= 0.0 && bin < nbin) {
+        const auto b = static_cast<scipp::index>(bin);
+        values[b] += weights[i];
+        variances[b] += weight_variances[i];
+      }
+    }
+    return;
+  }
+  const auto nbin = scipp::size(values);
+  if (!use_lanes(scipp::size(events), nbin)) {
+    for_each_bin(events, params,
+                 [&](const scipp::index i, const int32_t bin, scipp::index) {
+                   if (bin < nbin) {
+                     values[bin] += weights[i];
+                     variances[bin] += weight_variances[i];
+                   }
+                 });
+    return;
+  }
+  const auto stride = nbin + 1;
+  auto &sub = scratch(2 * lanes * stride);
+  const auto sub_variances = lanes * stride;
+  for_each_bin(events, params,
+               [&](const scipp::index i, const int32_t bin,
+                   const scipp::index lane) {
+                 sub[lane * stride + bin] += weights[i];
+                 sub[sub_variances + lane * stride + bin] +=
+                     weight_variances[i];
+               });
+  for (scipp::index lane = 0; lane < lanes; ++lane)
+    for (scipp::index bin = 0; bin < nbin; ++bin) {
+      values[bin] += sub[lane * stride + bin];
+      variances[bin] += sub[sub_variances + lane * stride + bin];
+    }
+}
+
+template void histogram_linear(const scipp::span<double> &,
+                               const scipp::span<const double> &,
+                               const std::array<double, 3> &);
+template void histogram_linear(const scipp::span<double> &,
+                               const scipp::span<const float> &,
+                               const std::array<double, 3> &);
+template void histogram_linear(const scipp::span<double> &,
+                               const scipp::span<const float> &,
+                               const std::array<float, 3> &);
+
+template void histogram_linear(
+    const scipp::span<double> &, const scipp::span<double> &,
+    const scipp::span<const double> &, const scipp::span<const double> &,
+    const scipp::span<const double> &, const std::array<double, 3> &);
+template void histogram_linear(
+    const scipp::span<double> &, const scipp::span<double> &,
+    const scipp::span<const float> &, const scipp::span<const double> &,
+    const scipp::span<const double> &, const std::array<double, 3> &);
+template void histogram_linear(
+    const scipp::span<double> &, const scipp::span<double> &,
+    const scipp::span<const float> &, const scipp::span<const double> &,
+    const scipp::span<const double> &, const std::array<float, 3> &);
+template void histogram_linear(
+    const scipp::span<double> &, const scipp::span<double> &,
+    const scipp::span<const double> &, const scipp::span<const float> &,
+    const scipp::span<const float> &, const std::array<double, 3> &);
+
+} // namespace scipp::core::histogram_detail
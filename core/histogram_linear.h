@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_HISTOGRAM_LINEAR_H
+#define SCIPP_CORE_HISTOGRAM_LINEAR_H
+
+#include <array>
+#include <cstdint>
+
+#include "scipp/common/index.h"
+#include "scipp/common/span.h"
+
+namespace scipp::core::histogram_detail {
+
+/// Add counts of `events` to `out`, for bins with constant width given by
+/// `params` as returned by linear_edge_params.
+///
+/// Uses a vectorized implementation of the bin-index computation if supported
+/// by the CPU (selected at runtime), falling back to scalar code otherwise.
+template <class Coord, class Edge>
+void histogram_linear(const scipp::span<double> &out,
+                      const scipp::span<const Coord> &events,
+                      const std::array<Edge, 3> &params);
+
+/// Add weights and variances of `events` to `values` and `variances`, for bins
+/// with constant width given by `params` as returned by linear_edge_params.
+template <class Coord, class Weight, class Edge>
+void histogram_linear(const scipp::span<double> &values,
+                      const scipp::span<double> &variances,
+                      const scipp::span<const Coord> &events,
+                      const scipp::span<const Weight> &weights,
+                      const scipp::span<const Weight> &weight_variances,
+                      const std::array<Edge, 3> &params);
+
+} // namespace scipp::core::histogram_detail
+
+#endif // SCIPP_CORE_HISTOGRAM_LINEAR_H
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_HISTOGRAM_LOOKUP_H
+#define SCIPP_CORE_HISTOGRAM_LOOKUP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "scipp/common/index.h"
+#include "scipp/common/numeric.h"
+#include "scipp/common/span.h"
+#include "scipp/core/histogram.h"
+
+namespace scipp::core::histogram_detail {
+
+/// Accelerator for finding the bin containing a value, for given bin edges.
+///
+/// Constructing the lookup copies and validates the edges. It is intended to
+/// be built once and shared by all event lists histogrammed with the same
+/// edges. For edges with constant bin width `linear()` returns true, allowing
+/// the caller to use a faster specialized implementation. Bins are found
+/// without a binary search over all edges:
+/// - For logarithmic edges the bin index is computed in closed form, up to a
+///   correction of at most one bin.
+/// - For arbitrary edges a uniform coarse grid covering the edges stores the
+///   bin containing the start of each grid cell, such that only the few edges
+///   within a cell need to be searched.
+template <class Edge> class EdgeLookup {
+public:
+  using edge_type = Edge;
+
+  template <class Range>
+  explicit EdgeLookup(const Range &edges)
+      : m_edges(edges.begin(), edges.end()) {
+    if (!(m_linear = scipp::numeric::is_linspace(m_edges)))
+      expect::histogram::sorted_edges(m_edges);
+    if (nbin() < 1)
+      return;
+    if (!(m_log = init_log()))
+      init_grid();
+  }
+
+  bool linear() const noexcept { return m_linear; }
+  scipp::span<const Edge> edges() const noexcept { return m_edges; }
+
+  /// Return the index of the bin containing `x`, or -1 if `x` is out of range.
+  template <class T> scipp::index operator()(const T x) const noexcept {
+    if (nbin() < 1 || !(x >= m_edges.front() && x < m_edges.back()))
+      return -1; // also for NaN
+    scipp::index begin;
+    scipp::index end;
+    if (m_log) {
+      const auto guess = cell(std::log(static_cast<double>(x)), nbin());
+      begin = std::max(guess - 1, scipp::index(0));
+      end = std::min(guess + 1, nbin() - 1);
+    } else {
+      const auto c = cell(static_cast<double>(x), grid_size());
+      begin = m_grid[std::max(c - 1, scipp::index(0))];
+      end = m_grid[std::min(c + 2, grid_size())];
+    }
+    // Bin is in [begin, end], i.e., search for the upper edge in
+    // [begin + 1, end + 1]. The upper edge exists since x < edges.back().
+    return std::upper_bound(m_edges.begin() + begin + 1,
+                            m_edges.begin() + end + 1, x) -
+           m_edges.begin() - 1;
+  }
+
+private:
+  /// Maximum number of grid cells per bin, and in total.
+  static constexpr scipp::index cells_per_bin = 4;
+  static constexpr scipp::index max_grid_size = 1 << 20;
+
+  scipp::index nbin() const noexcept { return scipp::size(m_edges) - 1; }
+  scipp::index grid_size() const noexcept {
+    return scipp::size(m_grid) - 1;
+  }
+
+  /// Return the index of the cell containing `x`, clipped to [0, size - 1].
+  scipp::index cell(const double x, const scipp::index size) const noexcept {
+    const auto c = static_cast<scipp::index>((x - m_offset) * m_scale);
+    return std::clamp(c, scipp::index(0), size - 1);
+  }
+
+  /// Check whether edges are logarithmic, i.e., the closed-form bin index is
+  /// off by no more than a quarter bin for all edges, and setup parameters.
+  bool init_log() {
+    if (!(m_edges.front() > 0))
+      return false;
+    m_offset = std::log(static_cast<double>(m_edges.front()));
+    const auto width =
+        (std::log(static_cast<double>(m_edges.back())) - m_offset) / nbin();
+    if (!(width > 0))
+      return false;
+    m_scale = 1.0 / width;
+    for (scipp::index i = 0; i <= nbin(); ++i) {
+      const auto pos =
+          (std::log(static_cast<double>(m_edges[i])) - m_offset) * m_scale;
+      if (!(std::abs(pos - static_cast<double>(i)) < 0.25))
+        return false;
+    }
+    return true;
+  }
+
+  /// Setup grid with the bin containing the start of each cell. Rounding
+  /// errors in the cell computation are handled in `operator()` by also
+  /// considering neighboring cells.
+  void init_grid() {
+    const auto size = std::min(cells_per_bin * nbin(), max_grid_size);
+    m_offset = static_cast<double>(m_edges.front());
+    const auto width = (static_cast<double>(m_edges.back()) - m_offset) / size;
+    m_scale = 1.0 / width;
+    m_grid.resize(size + 1);
+    scipp::index bin = 0;
+    for (scipp::index c = 0; c < size; ++c) {
+      const auto start = m_offset + c * width;
+      while (bin < nbin() - 1 && m_edges[bin + 1] <= start)
+        ++bin;
+      m_grid[c] = bin;
+    }
+    m_grid[size] = nbin() - 1;
+  }
+
+  std::vector<Edge> m_edges;
+  bool m_linear{false};
+  bool m_log{false};
+  double m_offset{0.0};
+  double m_scale{0.0};
+  std::vector<scipp::index> m_grid;
+};
+
+} // namespace scipp::core::histogram_detail
+
+#endif // SCIPP_CORE_HISTOGRAM_LOOKUP_H
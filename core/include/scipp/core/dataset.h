@@ -1220,6 +1220,11 @@ SCIPP_CORE_EXPORT DataArray concatenate(const DataArrayConstView &a,
 SCIPP_CORE_EXPORT Dataset concatenate(const DatasetConstView &a,
                                       const DatasetConstView &b, const Dim dim);
 
+SCIPP_CORE_EXPORT DataArray gather(const DataArrayConstView &a, const Dim dim,
+                                   const std::vector<scipp::index> &indices);
+SCIPP_CORE_EXPORT Dataset gather(const DatasetConstView &d, const Dim dim,
+                                 const std::vector<scipp::index> &indices);
+
 SCIPP_CORE_EXPORT DataArray rebin(const DataArrayConstView &a, const Dim dim,
                                   const VariableConstView &coord);
 SCIPP_CORE_EXPORT Dataset rebin(const DatasetConstView &d, const Dim dim,
@@ -7,15 +7,117 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
+#include "scipp-core_export.h"
 #include "scipp/common/index.h"
 #include "scipp/core/parallel.h"
 
-namespace scipp::core::detail {
+namespace scipp::core {
 
-/// Replacement for C++20 std::make_unique_default_init
-template <class T> auto make_unique_default_init(const scipp::index size) {
-  return std::unique_ptr<T>(new std::remove_extent_t<T>[size]);
+/// Allocation strategy for the element storage of variables.
+///
+/// - Default: Global operator new.
+/// - Aligned: Aligned to `storage_alignment` bytes (cache line, AVX-512).
+/// - Pool: Memory pool with 64 byte alignment, see MemoryPool.
+/// - HugePages: Large arrays are backed by transparent huge pages, if
+///   supported by the operating system.
+/// - FirstTouch: Aligned, elements are constructed in parallel such that pages
+///   are placed in the NUMA domain of the threads processing them. Note that
+///   for trivial types such as `double` with default-initialization pages are
+///   placed by the first (parallel) write in any case, provided the allocation
+///   obtained fresh pages from the operating system.
+/// - External: Memory owned by another object, such as a numpy array, that is
+///   kept alive by the array. Cannot be used as default allocator.
+enum class StorageAllocator {
+  Default,
+  Aligned,
+  Pool,
+  HugePages,
+  FirstTouch,
+  External
+};
+
+constexpr size_t storage_alignment = 64;
+
+SCIPP_CORE_EXPORT StorageAllocator
+to_storage_allocator(const std::string &name);
+SCIPP_CORE_EXPORT StorageAllocator default_storage_allocator() noexcept;
+SCIPP_CORE_EXPORT StorageAllocator
+set_default_storage_allocator(const StorageAllocator allocator) noexcept;
+
+/// Use given storage allocator for new variables within the current scope.
+///
+/// This affects all threads, i.e., the scope should not overlap with that of
+/// another ScopedStorageAllocator on a different thread.
+class ScopedStorageAllocator {
+public:
+  explicit ScopedStorageAllocator(const StorageAllocator allocator) noexcept
+      : m_previous(set_default_storage_allocator(allocator)) {}
+  ~ScopedStorageAllocator() { set_default_storage_allocator(m_previous); }
+  ScopedStorageAllocator(const ScopedStorageAllocator &) = delete;
+  ScopedStorageAllocator &operator=(const ScopedStorageAllocator &) = delete;
+
+private:
+  StorageAllocator m_previous;
+};
+
+namespace detail {
+
+SCIPP_CORE_EXPORT void *allocate_storage(const StorageAllocator allocator,
+                                         const size_t size, const size_t align);
+SCIPP_CORE_EXPORT void deallocate_storage(const StorageAllocator allocator,
+                                          void *ptr,
+                                          const size_t align) noexcept;
+
+/// Deleter for element storage, destroying elements and freeing memory with
+/// the allocator used for allocation. External storage is released by
+/// dropping the reference to its owner.
+template <class T> struct storage_deleter {
+  StorageAllocator allocator{StorageAllocator::Default};
+  scipp::index size{0};
+  mutable std::shared_ptr<const void> owner{};
+  void operator()(T *ptr) const noexcept {
+    if (allocator == StorageAllocator::External)
+      return owner.reset();
+    std::destroy_n(ptr, size);
+    deallocate_storage(allocator, ptr, alignof(T));
+  }
+};
+
+/// Return the allocator for a copy of an array using `allocator`.
+inline StorageAllocator copy_allocator(const StorageAllocator allocator) {
+  return allocator == StorageAllocator::External ? default_storage_allocator()
+                                                 : allocator;
+}
+
+template <class T>
+using storage_ptr = std::unique_ptr<T[], storage_deleter<T>>;
+
+/// Allocate storage for `size` default-initialized elements of type T.
+template <class T>
+storage_ptr<T> make_storage_default_init(const StorageAllocator allocator,
+                                         const scipp::index size) {
+  auto *ptr = static_cast<T *>(
+      allocate_storage(allocator, size * sizeof(T), alignof(T)));
+  if constexpr (!std::is_trivially_default_constructible_v<T>) {
+    if (allocator == StorageAllocator::FirstTouch &&
+        std::is_nothrow_default_constructible_v<T>) {
+      parallel::parallel_for(
+          parallel::blocked_range(0, size), [&](const auto &range) {
+            std::uninitialized_default_construct(ptr + range.begin(),
+                                                 ptr + range.end());
+          });
+    } else {
+      try {
+        std::uninitialized_default_construct_n(ptr, size);
+      } catch (...) {
+        deallocate_storage(allocator, ptr, alignof(T));
+        throw;
+      }
+    }
+  }
+  return storage_ptr<T>(ptr, storage_deleter<T>{allocator, size});
 }
 
 /// Tag for requesting default-initialization in methods of class element_array.
@@ -34,6 +136,9 @@ static constexpr auto default_init_elements = default_init_elements_t{};
 /// - As a minor benefit, since the implementation has to store a pointer and a
 ///   size, we can at the same time support an "optional" behavior, as used for
 ///   the array of variances in a variable.
+///
+/// Memory is obtained using the StorageAllocator that is the default at the
+/// time of construction. Copies use the same allocator as the original.
 template <class T> class element_array {
 public:
   using value_type = T;
@@ -42,10 +147,7 @@ public:
 
   explicit element_array(const scipp::index new_size, const T &value = T()) {
     resize(new_size, default_init_elements);
-    parallel::parallel_for(
-        parallel::blocked_range(0, size()), [&](const auto &range) {
-          std::fill(data() + range.begin(), data() + range.end(), value);
-        });
+    fill(value);
   }
 
   /// Construct with default-initialized elements. Use with care.
@@ -58,13 +160,7 @@ public:
       std::enable_if_t<
           std::is_assignable<T &, decltype(*std::declval<Iter>())>{}, int> = 0>
   element_array(Iter first, Iter last) {
-    const scipp::index size = std::distance(first, last);
-    resize(size, default_init_elements);
-    parallel::parallel_for(
-        parallel::blocked_range(0, size), [&](const auto &range) {
-          std::copy(first + range.begin(), first + range.end(),
-                    data() + range.begin());
-        });
+    assign(first, last);
   }
 
   template <
@@ -77,23 +173,43 @@ public:
   element_array(std::initializer_list<T> init)
       : element_array(init.begin(), init.end()) {}
 
+  /// Construct from `size` elements at `data`, without copying.
+  ///
+  /// The memory is owned by `owner`, which is kept alive by the array and its
+  /// moved-to instances. Copies of the array use the default allocator.
+  element_array(T *data, const scipp::index size,
+                std::shared_ptr<const void> owner) noexcept
+      : m_size(size), m_allocator(StorageAllocator::External),
+        m_data(data, storage_deleter<T>{StorageAllocator::External, size,
+                                        std::move(owner)}) {}
+
   element_array(element_array &&other) noexcept
-      : m_size(other.m_size), m_data(std::move(other.m_data)) {
+      : m_size(other.m_size), m_allocator(other.m_allocator),
+        m_data(std::move(other.m_data)) {
     other.m_size = -1;
   }
 
   element_array(const element_array &other)
-      : element_array(from_other(other)) {}
+      : m_allocator(copy_allocator(other.m_allocator)) {
+    if (other.size() == 0)
+      m_size = 0;
+    else if (other.size() > 0)
+      assign(other.begin(), other.end());
+  }
 
   element_array &operator=(element_array &&other) noexcept {
     m_data = std::move(other.m_data);
     m_size = other.m_size;
+    m_allocator = other.m_allocator;
     other.m_size = -1;
     return *this;
   }
 
   element_array &operator=(const element_array &other) {
-    return *this = element_array(other.begin(), other.end());
+    element_array copy;
+    copy.m_allocator = copy_allocator(other.m_allocator);
+    copy.assign(other.begin(), other.end());
+    return *this = std::move(copy);
   }
 
   explicit operator bool() const noexcept { return m_size != -1; }
@@ -105,6 +221,7 @@ public:
   const T *end() const noexcept {
     return m_size < 0 ? begin() : data() + size();
   }
+  StorageAllocator allocator() const noexcept { return m_allocator; }
 
   void reset() noexcept {
     m_data.reset();
@@ -115,7 +232,11 @@ public:
   ///
   /// Unlike std::vector::resize, this does *not* preserve existing element
   /// values.
-  void resize(const scipp::index new_size) { *this = element_array(new_size); }
+  void resize(const scipp::index new_size) {
+    reset();
+    resize(new_size, default_init_elements);
+    fill(T());
+  }
 
   /// Resize with default-initialized elements. Use with care.
   void resize(const scipp::index new_size, const default_init_elements_t &) {
@@ -123,25 +244,37 @@ public:
       m_data.reset();
       m_size = 0;
     } else if (new_size != size()) {
-      m_data = make_unique_default_init<T[]>(new_size);
+      m_data.reset();
+      m_allocator = copy_allocator(m_allocator);
+      m_data = make_storage_default_init<T>(m_allocator, new_size);
       m_size = new_size;
     }
   }
 
 private:
-  element_array from_other(const element_array &other) {
-    if (other.size() == -1) {
-      return element_array();
-    } else if (other.size() == 0) {
-      return element_array(0);
-    } else {
-      return element_array(other.begin(), other.end());
-    }
+  void fill(const T &value) {
+    parallel::parallel_for(
+        parallel::blocked_range(0, size()), [&](const auto &range) {
+          std::fill(data() + range.begin(), data() + range.end(), value);
+        });
+  }
+
+  template <class Iter> void assign(Iter first, Iter last) {
+    const scipp::index size = std::distance(first, last);
+    resize(size, default_init_elements);
+    parallel::parallel_for(
+        parallel::blocked_range(0, size), [&](const auto &range) {
+          std::copy(first + range.begin(), first + range.end(),
+                    data() + range.begin());
+        });
   }
+
   scipp::index m_size{-1};
-  std::unique_ptr<T[]> m_data;
+  StorageAllocator m_allocator{default_storage_allocator()};
+  storage_ptr<T> m_data;
 };
 
-} // namespace scipp::core::detail
+} // namespace detail
+} // namespace scipp::core
 
 #endif // SCIPP_CORE_ELEMENT_ARRAY_H
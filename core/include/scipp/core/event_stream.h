@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_EVENT_STREAM_H
+#define SCIPP_CORE_EVENT_STREAM_H
+
+#include <map>
+#include <string>
+
+#include "scipp-core_export.h"
+#include "scipp/core/dataset.h"
+#include "scipp/core/histogram_accumulator.h"
+
+namespace scipp::core {
+
+namespace sparse {
+/// Append a batch of events to the event lists of `events` in place.
+///
+/// `index` is the flat index of the event list (row-major in the dense
+/// dimensions of `events`) of each event. `batch` holds the new events as
+/// 1-D dense data array along the sparse dimension of `events`, with the
+/// sparse coordinate, the sparse labels, and the weights. The data of
+/// `batch` is ignored if `events` has no data, since a data array without
+/// data cannot have a dense coordinate. The cost is proportional to the
+/// number of appended events, not the number of existing events.
+SCIPP_CORE_EXPORT void append(const DataArrayView &events,
+                              const VariableConstView &index,
+                              const DataArrayConstView &batch);
+} // namespace sparse
+
+/// Sparse data that grows by appending batches of events, e.g., pulses from
+/// a live acquisition stream.
+///
+/// Histograms of the events can be registered with `addHistogram`. They are
+/// updated from the new events of each batch instead of being recomputed.
+class SCIPP_CORE_EXPORT EventStream {
+public:
+  explicit EventStream(DataArray events);
+
+  /// Append a batch of events, see `sparse::append`.
+  void append(const VariableConstView &index, const DataArrayConstView &batch);
+
+  /// Add a histogram of the events for given 1-D bin edges, which is kept up
+  /// to date when appending.
+  void addHistogram(const std::string &name, const VariableConstView &binEdges);
+
+  const DataArray &events() const noexcept { return m_events; }
+  const DataArray &histogram(const std::string &name) const;
+
+private:
+  DataArray m_events;
+  std::map<std::string, HistogramAccumulator> m_histograms;
+};
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_EVENT_STREAM_H
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_HISTOGRAM_ACCUMULATOR_H
+#define SCIPP_CORE_HISTOGRAM_ACCUMULATOR_H
+
+#include <memory>
+#include <optional>
+
+#include "scipp-core_export.h"
+#include "scipp/core/dataset.h"
+
+namespace scipp::core {
+
+struct SharedEdgeLookup;
+
+/// Histogram of event data that is added in batches.
+///
+/// `histogram` requires all events in memory. The accumulator instead holds
+/// only the histogram, such that event data larger than the available memory
+/// can be histogrammed by reading and adding it in chunks, e.g., per time
+/// interval or per range of spectra. Adding all events in any number of
+/// batches gives the same result as histogramming them at once, up to
+/// rounding when summing weights.
+class SCIPP_CORE_EXPORT HistogramAccumulator {
+public:
+  /// Construct an empty histogram with dense dimensions `dims` and 1-D bin
+  /// edges `binEdges`. The dimension of the edges is the sparse dimension of
+  /// the events.
+  HistogramAccumulator(const Dimensions &dims,
+                       const VariableConstView &binEdges);
+  HistogramAccumulator(HistogramAccumulator &&) noexcept;
+  HistogramAccumulator &operator=(HistogramAccumulator &&) noexcept;
+  ~HistogramAccumulator();
+
+  /// Add events given as sparse data, with the sparse coordinate for the
+  /// dimension of the bin edges and optional weights with variances.
+  ///
+  /// The dense dimensions of `events` must match the histogram, or a slice
+  /// of it if `slice` is given, e.g., for adding a chunk of spectra.
+  void add(const DataArrayConstView &events,
+           const std::optional<Slice> &slice = std::nullopt);
+  /// Add events given as flat arrays. `index` is the flat index of the
+  /// histogram (row-major in the dense dimensions) each event belongs to,
+  /// `coord` the event coordinate, and `weights` optional weights with
+  /// variances. All arrays must be 1-D with the same length.
+  void add(const VariableConstView &index, const VariableConstView &coord,
+           const std::optional<VariableConstView> &weights = std::nullopt);
+
+  /// Return the histogram of all events added so far.
+  const DataArray &result() const noexcept { return m_histogram; }
+
+private:
+  void set_unit(const units::Unit &coord_unit,
+                const std::optional<units::Unit> &weights_unit);
+
+  Dim m_dim;
+  DataArray m_histogram;
+  std::unique_ptr<SharedEdgeLookup> m_lookup;
+  bool m_empty{true};
+};
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_HISTOGRAM_ACCUMULATOR_H
@@ -37,6 +37,10 @@ public:
   constexpr Dim dim() const noexcept { return m_dim; }
   /// Number of slices.
   constexpr scipp::index size() const noexcept { return m_index.size(); }
+  /// Underlying data that is sliced.
+  constexpr const T &data() const noexcept { return *m_data; }
+  /// Indices of the slices.
+  const std::vector<scipp::index> &indices() const noexcept { return m_index; }
 
   /// The slice with given index.
   auto operator[](const scipp::index index) const {
@@ -59,13 +63,11 @@ private:
 };
 
 /// Concatenate all slices of an IndexedSliceView along the view's dimension.
+///
+/// This is implemented using `gather`, i.e., the output is allocated once and
+/// runs of consecutive indices are copied in bulk.
 template <class T> auto concatenate(const IndexedSliceView<T> &view) {
-  // TODO Recursive implementation a bit like merge sort for better performance.
-  // Could also try to find continuous ranges in indices.
-  auto out = copy(view[0]);
-  for (scipp::index i = 1; i < view.size(); ++i)
-    out = concatenate(out, view[i], view.dim());
-  return out;
+  return gather(view.data(), view.dim(), view.indices());
 }
 
 } // namespace scipp::core
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_IO_H
+#define SCIPP_CORE_IO_H
+
+#include <string>
+#include <variant>
+
+#include "scipp-core_export.h"
+#include "scipp/core/dataset.h"
+#include "scipp/core/except.h"
+#include "scipp/core/packed_events.h"
+
+/// Native binary file format for variables, data arrays, and datasets.
+///
+/// Files store the raw buffers of all variables, aligned such that they can be
+/// used in place after memory-mapping the file. Loading a file thus reads only
+/// the metadata. The data of dense variables and packed events is paged in on
+/// first access, e.g., only the touched ranges when working with a slice.
+/// Strings, sparse variables, and nested data arrays or datasets are copied
+/// into memory on load.
+///
+/// The format is intended for checkpointing, not for archiving. It is not
+/// portable between machines with different byte order, and files must be
+/// loaded with the scipp version used to write them.
+namespace scipp::core::io {
+
+/// Content of a file.
+using Object = std::variant<Variable, DataArray, Dataset, PackedEvents>;
+
+SCIPP_CORE_EXPORT void save(const VariableConstView &var,
+                            const std::string &filename);
+SCIPP_CORE_EXPORT void save(const DataArrayConstView &array,
+                            const std::string &filename);
+SCIPP_CORE_EXPORT void save(const DatasetConstView &dataset,
+                            const std::string &filename);
+SCIPP_CORE_EXPORT void save(const PackedEvents &events,
+                            const std::string &filename);
+
+[[nodiscard]] SCIPP_CORE_EXPORT Object load(const std::string &filename);
+
+/// Load a file, throwing if it does not contain an object of type T.
+template <class T> [[nodiscard]] T load(const std::string &filename) {
+  auto object = load(filename);
+  if (!std::holds_alternative<T>(object))
+    throw except::TypeError("File `" + filename +
+                            "` does not contain an object of the requested "
+                            "type.");
+  return std::get<T>(std::move(object));
+}
+
+} // namespace scipp::core::io
+
+#endif // SCIPP_CORE_IO_H
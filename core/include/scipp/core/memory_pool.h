@@ -6,9 +6,12 @@
 #define SCIPP_CORE_MEMORY_POOL_H
 
 #include <array>
-#include <map>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
 #include <mutex>
-#include <vector>
+#include <new>
 
 #include "scipp/common/index.h"
 
@@ -38,57 +41,255 @@ static int posix_memalign(void **ptr, size_t align, size_t size) {
 }
 #endif
 
+/// Memory pool with power-of-two size classes and thread-local caching.
+///
+/// Every block is preceded by a header of `alignment` bytes storing its size
+/// class, so deallocation is O(1). Freed blocks are kept in one of several
+/// cache slots, each owned (typically) by a single thread, and only overflow or
+/// misses of a slot touch the central free list of the respective size class.
+/// There is no global lock. All returned pointers are aligned to 64 bytes.
 class MemoryPool {
 public:
-  void *allocate(size_t size) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    auto &pools = m_pools[size];
-    if (pools[1].empty()) {
-      void *ptr = nullptr;
-      // Always 64 bit aligned
-      int rc = posix_memalign(&ptr, 64, size);
-      if (rc != 0)
-        throw std::runtime_error("Failed to allocate.");
-      pools[0].emplace_back(ptr);
-      return ptr;
-    } else {
-      pools[0].emplace_back(pools[1].back());
-      pools[1].pop_back();
-      return pools[0].back();
+  /// Alignment of all returned pointers, also the size of the block header.
+  static constexpr size_t alignment = 64;
+  static constexpr int32_t min_class = 6;   // 64 Byte
+  static constexpr int32_t num_classes = 42; // up to 2^47 Byte
+  static constexpr int32_t num_slots = 64;
+  /// Maximum number of bytes cached per size class in a cache slot.
+  static constexpr size_t slot_capacity = size_t(16) << 20;
+
+  struct Statistics {
+    scipp::index bytes_live{0};
+    scipp::index bytes_peak{0};
+    scipp::index allocations{0};
+    scipp::index hits{0};
+
+    /// Fraction of allocations served from previously freed blocks.
+    double hit_rate() const noexcept {
+      return allocations == 0 ? 0.0 : static_cast<double>(hits) / allocations;
+    }
+  };
+
+  MemoryPool() = default;
+  MemoryPool(const MemoryPool &) = delete;
+  MemoryPool &operator=(const MemoryPool &) = delete;
+
+  ~MemoryPool() {
+    for (auto &slot : m_slots)
+      for (auto &list : slot.lists)
+        free_list(list.head);
+    for (auto &central : m_central)
+      free_list(central.list.head);
+  }
+
+  void *allocate(size_t size) {
+    const auto cls = size_class(size);
+    if (cls >= num_classes)
+      throw std::bad_alloc();
+    const auto bytes = class_size(cls);
+    auto &slot = this_slot();
+    Header *block = nullptr;
+    {
+      SlotLock lock(slot);
+      block = slot.lists[cls].pop();
+      increment(slot.allocations);
+      if (block)
+        increment(slot.hits);
+    }
+    if (!block) {
+      auto &central = m_central[cls];
+      std::lock_guard<std::mutex> g(central.mutex);
+      block = central.list.pop();
+      if (block)
+        increment(central.hits);
     }
+    if (!block)
+      block = allocate_block(cls);
+    record_bytes(bytes);
+    return payload(block);
   }
-  void deallocate(void *ptr) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    for (auto &pools : m_pools) {
-      auto &used = pools.second[0];
-      for (scipp::index i = used.size() - 1; i >= 0; --i) {
-        if (used[i] == ptr) {
-          auto &unused = pools.second[1];
-          used.erase(used.begin() + i);
-          unused.emplace_back(ptr);
-          return;
-        }
+
+  void deallocate(void *ptr) noexcept {
+    if (!ptr)
+      return;
+    auto *block = header(ptr);
+    const auto cls = block->size_class;
+    const auto bytes = class_size(cls);
+    m_bytes_live.fetch_sub(static_cast<scipp::index>(bytes),
+                           std::memory_order_relaxed);
+    auto &slot = this_slot();
+    Header *overflow = nullptr;
+    {
+      SlotLock lock(slot);
+      auto &list = slot.lists[cls];
+      list.push(block);
+      // Keep at least one block per class, otherwise limit cached bytes.
+      if (list.count > 1 && list.count * bytes > slot_capacity)
+        overflow = list.split_half();
+    }
+    if (overflow) {
+      auto &central = m_central[cls];
+      std::lock_guard<std::mutex> g(central.mutex);
+      central.list.push_all(overflow);
+    }
+  }
+
+  Statistics statistics() const noexcept {
+    Statistics stats;
+    stats.bytes_live = m_bytes_live.load(std::memory_order_relaxed);
+    stats.bytes_peak = m_bytes_peak.load(std::memory_order_relaxed);
+    for (const auto &slot : m_slots) {
+      stats.allocations += slot.allocations.load(std::memory_order_relaxed);
+      stats.hits += slot.hits.load(std::memory_order_relaxed);
+    }
+    for (const auto &central : m_central)
+      stats.hits += central.hits.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  /// Return the number of bytes reserved for an allocation of `size` bytes,
+  /// excluding the block header. Only valid for sizes the pool can allocate.
+  static size_t allocation_size(const size_t size) noexcept {
+    return class_size(size_class(size));
+  }
+
+private:
+  struct alignas(alignment) Header {
+    Header *next;
+    int32_t size_class;
+  };
+  static_assert(sizeof(Header) == alignment);
+
+  struct FreeList {
+    Header *head{nullptr};
+    scipp::index count{0};
+
+    Header *pop() noexcept {
+      auto *block = head;
+      if (block) {
+        head = block->next;
+        --count;
       }
+      return block;
+    }
+    void push(Header *block) noexcept {
+      block->next = head;
+      head = block;
+      ++count;
     }
-    throw std::runtime_error(
-        "Request to deallocate memory that is not owned by us.");
+    void push_all(Header *blocks) noexcept {
+      while (blocks) {
+        auto *next = blocks->next;
+        push(blocks);
+        blocks = next;
+      }
+    }
+    /// Remove and return the first half of the list.
+    Header *split_half() noexcept {
+      const auto n = count / 2;
+      auto *first = head;
+      auto *last = head;
+      for (scipp::index i = 1; i < n; ++i)
+        last = last->next;
+      head = last->next;
+      last->next = nullptr;
+      count -= n;
+      return first;
+    }
+  };
+
+  struct alignas(alignment) Slot {
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    std::array<FreeList, num_classes> lists;
+    std::atomic<scipp::index> allocations{0};
+    std::atomic<scipp::index> hits{0};
+  };
+
+  /// Spin lock for a cache slot. Slots are shared only if more than
+  /// `num_slots` threads use the pool so this is practically uncontended.
+  class SlotLock {
+  public:
+    explicit SlotLock(Slot &slot) noexcept : m_slot(slot) {
+      while (m_slot.busy.test_and_set(std::memory_order_acquire))
+        ;
+    }
+    ~SlotLock() { m_slot.busy.clear(std::memory_order_release); }
+    SlotLock(const SlotLock &) = delete;
+    SlotLock &operator=(const SlotLock &) = delete;
+
+  private:
+    Slot &m_slot;
+  };
+
+  struct alignas(alignment) Central {
+    std::mutex mutex;
+    FreeList list;
+    std::atomic<scipp::index> hits{0};
+  };
+
+  static int32_t size_class(const size_t size) noexcept {
+    int32_t cls = 0;
+    while (cls < num_classes && (size_t(1) << (cls + min_class)) < size)
+      ++cls;
+    return cls;
   }
-  ~MemoryPool() {
-    for (auto &pools : m_pools) {
-      for (auto &pool : pools.second)
-        for (auto &ptr : pool)
+  static size_t class_size(const int32_t cls) noexcept {
+    return size_t(1) << (cls + min_class);
+  }
+  static void *payload(Header *block) noexcept {
+    return reinterpret_cast<char *>(block) + alignment;
+  }
+  static Header *header(void *ptr) noexcept {
+    return reinterpret_cast<Header *>(static_cast<char *>(ptr) - alignment);
+  }
+
+  static Header *allocate_block(const int32_t cls) {
+    void *ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, alignment + class_size(cls)) != 0)
+      throw std::bad_alloc();
+    return new (ptr) Header{nullptr, cls};
+  }
+  static void free_list(Header *block) noexcept {
+    while (block) {
+      auto *next = block->next;
 #ifdef _WIN32
-          _aligned_free(ptr);
+      _aligned_free(block);
 #else
-          free(ptr);
+      free(block);
 #endif
+      block = next;
     }
   }
 
-private:
-  mutable std::mutex m_mutex;
-  // Different pool for each size.
-  mutable std::map<size_t, std::array<std::vector<void *>, 2>> m_pools;
+  Slot &this_slot() noexcept {
+    static std::atomic<int32_t> next_thread{0};
+    thread_local const int32_t thread =
+        next_thread.fetch_add(1, std::memory_order_relaxed);
+    return m_slots[thread % num_slots];
+  }
+
+  /// Increment a counter that is modified only under a lock, but may be read
+  /// concurrently by `statistics()`. Avoids the cost of an atomic increment.
+  static void increment(std::atomic<scipp::index> &counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  void record_bytes(const size_t bytes) noexcept {
+    const auto live =
+        m_bytes_live.fetch_add(static_cast<scipp::index>(bytes),
+                               std::memory_order_relaxed) +
+        static_cast<scipp::index>(bytes);
+    auto peak = m_bytes_peak.load(std::memory_order_relaxed);
+    while (live > peak && !m_bytes_peak.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed))
+      ;
+  }
+
+  std::array<Slot, num_slots> m_slots;
+  std::array<Central, num_classes> m_central;
+  std::atomic<scipp::index> m_bytes_live{0};
+  std::atomic<scipp::index> m_bytes_peak{0};
 };
 
 inline MemoryPool &instance() {
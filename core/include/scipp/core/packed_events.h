@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#ifndef SCIPP_CORE_PACKED_EVENTS_H
+#define SCIPP_CORE_PACKED_EVENTS_H
+
+#include <memory>
+
+#include "scipp/core/variable.h"
+
+namespace scipp::core {
+
+/// Event lists of all elements stored in a single contiguous buffer.
+///
+/// A sparse variable holds a separate `sparse_container` for every element,
+/// i.e., a separate heap allocation and unrelated memory locations for values
+/// and variances. PackedEvents instead stores all events in a 1-D buffer,
+/// with the event list of each element given by the range [begin, end) of
+/// buffer indices. Copying, histogramming, or serializing event data thus
+/// amounts to processing a few large contiguous arrays.
+///
+/// The buffer is never modified and is shared between copies and slices of
+/// PackedEvents. Use `copy` to obtain a compact buffer for a slice.
+class SCIPP_CORE_EXPORT PackedEvents {
+public:
+  /// Construct from index ranges into `buffer`, which must be 1-D. The
+  /// dimension of `buffer` is the sparse dimension of the event lists.
+  PackedEvents(Variable begin, Variable end, Variable buffer);
+
+  Dimensions dims() const;
+  /// Return the dtype of the events, e.g., `double` for `sparse_double`.
+  DType dtype() const noexcept { return buffer().dtype(); }
+  units::Unit unit() const { return buffer().unit(); }
+  bool hasVariances() const noexcept { return buffer().hasVariances(); }
+
+  const Variable &begin() const noexcept { return m_begin; }
+  const Variable &end() const noexcept { return m_end; }
+  const Variable &buffer() const noexcept { return *m_buffer; }
+
+  PackedEvents slice(const Slice slice) const;
+  Variable view() const;
+
+  bool operator==(const PackedEvents &other) const;
+  bool operator!=(const PackedEvents &other) const;
+
+private:
+  Variable m_begin;
+  Variable m_end;
+  std::shared_ptr<const Variable> m_buffer;
+};
+
+[[nodiscard]] SCIPP_CORE_EXPORT PackedEvents copy(const PackedEvents &events);
+[[nodiscard]] SCIPP_CORE_EXPORT PackedEvents flatten(const PackedEvents &events,
+                                                     const Dim dim);
+[[nodiscard]] SCIPP_CORE_EXPORT Variable
+histogram(const PackedEvents &events, const VariableConstView &binEdges);
+
+namespace sparse {
+[[nodiscard]] SCIPP_CORE_EXPORT PackedEvents pack(const VariableConstView &var);
+[[nodiscard]] SCIPP_CORE_EXPORT Variable unpack(const PackedEvents &events);
+[[nodiscard]] SCIPP_CORE_EXPORT PackedEvents
+from_offsets(const VariableConstView &offsets, Variable buffer);
+[[nodiscard]] SCIPP_CORE_EXPORT Variable offsets(const PackedEvents &events);
+} // namespace sparse
+
+} // namespace scipp::core
+
+#endif // SCIPP_CORE_PACKED_EVENTS_H
@@ -23,6 +23,9 @@
 #ifndef SCIPP_CORE_TRANSFORM_H
 #define SCIPP_CORE_TRANSFORM_H
 
+#include <algorithm>
+#include <limits>
+
 #include "scipp/common/overloaded.h"
 #include "scipp/core/except.h"
 #include "scipp/core/parallel.h"
@@ -167,6 +170,110 @@ static constexpr auto has_stride_zero(const T &index) noexcept {
     return index.has_stride_zero();
 }
 
+template <class T> struct has_view_index : std::false_type {};
+template <class... Ts>
+struct has_view_index<std::tuple<Ts...>>
+    : std::disjunction<std::is_same<Ts, ViewIndex>...> {};
+
+template <class T> static constexpr auto full_index(const T &index) noexcept {
+  if constexpr (std::is_integral_v<T>)
+    return index;
+  else
+    return index.index();
+}
+
+template <class T, size_t... I>
+static constexpr scipp::index
+row_length_impl(const T &indices, std::index_sequence<I...>) noexcept {
+  scipp::index length = std::numeric_limits<scipp::index>::max();
+  auto shorten = [&length](const auto &i) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(i)>, ViewIndex>)
+      length = std::min(length, i.inner_remaining());
+  };
+  (shorten(std::get<I>(indices)), ...);
+  return length;
+}
+/// Return the number of elements until the end of the current row of the
+/// innermost dimension. All ViewIndex in `indices` share the same iteration
+/// dimensions, so their rows end at the same point.
+template <class T> static constexpr auto row_length(const T &indices) noexcept {
+  return row_length_impl(indices,
+                         std::make_index_sequence<std::tuple_size_v<T>>{});
+}
+
+template <class T> static constexpr auto stride(const T &index) noexcept {
+  if constexpr (std::is_integral_v<T>)
+    return scipp::index{1};
+  else
+    return index.inner_stride();
+}
+
+template <class T, size_t... I>
+static constexpr void advance_row_impl(T &&indices, const scipp::index n,
+                                       std::index_sequence<I...>) noexcept {
+  auto inc = [n](auto &&i) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(i)>, ViewIndex>)
+      i.increment_inner(n);
+    else
+      i += n;
+  };
+  (inc(std::get<I>(indices)), ...);
+}
+template <class T>
+static constexpr void advance_row(T &indices, const scipp::index n) noexcept {
+  advance_row_impl(indices, n,
+                   std::make_index_sequence<std::tuple_size_v<T>>{});
+}
+
+/// Call `func` with a tuple of plain integer indices for each element in the
+/// range [indices, end).
+///
+/// If any of the indices is a ViewIndex the range is processed row by row,
+/// i.e., in chunks along the innermost dimension. Within a row the offsets are
+/// computed directly from the row start and the strides, so the branching of
+/// ViewIndex::increment is paid only once per row. The common case of all
+/// strides being 1 (contiguous inner dimension) uses a simple counted loop
+/// which the compiler can vectorize.
+template <class Indices, class End, class Func>
+static void for_each(Indices indices, const End &end, Func &&func) {
+  if constexpr (!has_view_index<Indices>::value) {
+    for (; std::get<0>(indices) != end; increment(indices))
+      func(indices);
+  } else {
+    const auto last = full_index(end);
+    for (auto i = full_index(std::get<0>(indices)); i != last;) {
+      const auto n = std::min(row_length(indices), last - i);
+      const auto base = std::apply(
+          [](const auto &... j) { return std::tuple{iter::get(j)...}; },
+          indices);
+      const auto strides = std::apply(
+          [](const auto &... j) { return std::tuple{iter::stride(j)...}; },
+          indices);
+      const bool contiguous = std::apply(
+          [](const auto &... s) { return ((s == 1) && ...); }, strides);
+      if (contiguous) {
+        for (scipp::index k = 0; k < n; ++k)
+          func(std::apply(
+              [k](const auto &... b) { return std::tuple{(b + k)...}; },
+              base));
+      } else {
+        for (scipp::index k = 0; k < n; ++k)
+          func(std::apply(
+              [k, &strides](const auto &... b) {
+                return std::apply(
+                    [&](const auto &... s) {
+                      return std::tuple{(b + k * s)...};
+                    },
+                    strides);
+              },
+              base));
+      }
+      advance_row(indices, n);
+      i += n;
+    }
+  }
+}
+
 } // namespace iter
 
 template <class Op, class Indices, class... Args, size_t... I>
@@ -229,8 +336,8 @@ static constexpr void call_in_place(Op &&op, const Indices &indices, Arg &&arg,
 template <class Op, class Out, class... Ts>
 static void transform_elements(Op op, Out &&out, Ts &&... other) {
   auto run = [&](auto indices, const auto &end) {
-    for (; std::get<0>(indices) != end; iter::increment(indices))
-      call(op, indices, out, other...);
+    iter::for_each(indices, end,
+                   [&](const auto &i) { call(op, i, out, other...); });
   };
   const auto begin =
       std::tuple{iter::begin_index(out), iter::begin_index(other)...};
@@ -519,6 +626,40 @@ static constexpr auto type_tuples(Op) noexcept {
 /// of data. This is used to implement operations on datasets with a strong
 /// exception guarantee.
 template <bool dry_run> struct in_place {
+  /// Run `run` in parallel over chunks of the outermost output dimension with
+  /// non-zero stride.
+  ///
+  /// Each chunk covers a disjoint set of output elements, and each output
+  /// element is updated by a single thread, in the same order as for serial
+  /// iteration. Results are thus identical to a serial run. The extent of
+  /// dimensions outside the chunked dimension is iterated within each chunk.
+  template <class Run, class Indices, class T>
+  static void run_partitioned(Run &run, const Indices &begin, const T &arg) {
+    using namespace detail;
+    const auto &index = std::get<0>(begin);
+    const auto dim = index.outer_strided_dim();
+    if (dim < 0) {
+      // Output is a scalar, nothing to partition.
+      run(begin, iter::end_index(arg));
+      return;
+    }
+    scipp::index inner = 1;
+    for (int32_t d = 0; d < dim; ++d)
+      inner *= index.extent(d);
+    const auto extent = index.extent(dim);
+    const auto outer = extent * inner == 0 ? 0 : arg.size() / (extent * inner);
+    auto run_chunk = [&](const auto &range) {
+      for (scipp::index o = 0; o < outer; ++o) {
+        auto indices = begin;
+        iter::advance(indices, (o * extent + range.begin()) * inner);
+        auto end = std::tuple{iter::begin_index(arg)};
+        iter::advance(end, (o * extent + range.end()) * inner);
+        run(indices, std::get<0>(end));
+      }
+    };
+    parallel::parallel_for(parallel::blocked_range(0, extent), run_chunk);
+  }
+
   template <class Op, class T, class... Ts>
   static void transform_in_place_impl(Op op, T &&arg, Ts &&... other) {
     using namespace detail;
@@ -542,8 +683,9 @@ template <bool dry_run> struct in_place {
     if constexpr (dry_run)
       return;
     auto run = [&](auto indices, const auto &end) {
-      for (; std::get<0>(indices) != end; iter::increment(indices))
-        call_in_place(op, indices, arg, other...);
+      iter::for_each(indices, end, [&](const auto &i) {
+        call_in_place(op, i, arg, other...);
+      });
     };
 
     if constexpr (transform_detail::is_sparse_v<std::decay_t<T>> ||
@@ -553,9 +695,13 @@ template <bool dry_run> struct in_place {
       if (iter::has_stride_zero(std::get<0>(begin))) {
         // The output has a dimension with stride zero so parallelization must
         // be done differently. Explicit and precise control of chunking is
-        // required to avoid multiple threads writing to the same output. Not
-        // implemented for now.
-        run(begin, iter::end_index(arg));
+        // required to avoid multiple threads writing to the same output.
+        if constexpr (std::is_same_v<std::decay_t<decltype(std::get<0>(begin))>,
+                                     ViewIndex>) {
+          run_partitioned(run, begin, arg);
+        } else {
+          run(begin, iter::end_index(arg));
+        }
       } else {
         auto run_parallel = [&](const auto &range) {
           auto indices = begin;
@@ -826,7 +972,9 @@ template <class... TypePairs, class Var, class Op>
 void accumulate_in_place(Var &&var, const VariableConstView &var1,
                          const VariableConstView &var2, Op op) {
   expect::contains(var1.dims(), var.dims());
-  expect::contains(var2.dims(), denseDims(var.dims()));
+  // `var2` may be broadcast, e.g., a mask that does not depend on all
+  // dimensions of `var1`.
+  expect::contains(var1.dims(), var2.dims());
   in_place<false>::transform_data(type_tuples<TypePairs...>(op), op,
                                   std::forward<Var>(var), var1, var2);
 }
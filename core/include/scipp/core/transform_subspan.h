@@ -12,7 +12,10 @@ namespace scipp::core {
 
 namespace transform_subspan_detail {
 static constexpr auto erase = [](Dimensions dims, const Dim dim) {
-  dims.erase(dim);
+  // Inputs that do not depend on `dim`, such as spans of packed events, are
+  // passed as a whole to every call of the operator.
+  if (dims.contains(dim))
+    dims.erase(dim);
   return dims;
 };
 static constexpr auto need_subspan = [](const VariableConstView &var,
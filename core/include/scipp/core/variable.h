@@ -994,6 +994,8 @@ SCIPP_CORE_EXPORT Variable concatenate(const VariableConstView &a1,
                                        const Dim dim);
 SCIPP_CORE_EXPORT Variable dot(const Variable &a, const Variable &b);
 SCIPP_CORE_EXPORT Variable filter(const Variable &var, const Variable &filter);
+SCIPP_CORE_EXPORT Variable gather(const VariableConstView &var, const Dim dim,
+                                  const std::vector<scipp::index> &indices);
 [[nodiscard]] SCIPP_CORE_EXPORT Variable mean(const VariableConstView &var,
                                               const Dim dim);
 SCIPP_CORE_EXPORT VariableView mean(const VariableConstView &var, const Dim dim,
@@ -5,6 +5,8 @@
 #ifndef SCIPP_CORE_VIEW_INDEX_H
 #define SCIPP_CORE_VIEW_INDEX_H
 
+#include <algorithm>
+
 #include "scipp-core_export.h"
 #include "scipp/core/dimensions.h"
 
@@ -32,6 +34,22 @@ public:
     ++m_fullIndex;
   }
 
+  /// Advance by `n` elements, which must not exceed inner_remaining().
+  constexpr void increment_inner(const scipp::index n) noexcept {
+    m_index += n * m_delta[0];
+    m_coord[0] += n;
+    if (m_coord[0] == m_extent[0])
+      increment_outer();
+    m_fullIndex += n;
+  }
+  /// Return the number of elements until the end of the current row of the
+  /// innermost dimension, including the current element.
+  constexpr scipp::index inner_remaining() const noexcept {
+    return m_dims == 0 ? 1 : m_extent[0] - m_coord[0];
+  }
+  /// Return the step of get() between consecutive elements of a row.
+  constexpr scipp::index inner_stride() const noexcept { return m_delta[0]; }
+
   constexpr void setIndex(const scipp::index index) noexcept {
     m_fullIndex = index;
     if (m_dims == 0)
@@ -59,6 +77,20 @@ public:
 
   constexpr bool has_stride_zero() const noexcept { return m_dims > m_subdims; }
 
+  /// Return the outermost dimension with non-zero stride, -1 if there is none.
+  ///
+  /// Dimensions are numbered starting with 0 for the innermost dimension.
+  constexpr int32_t outer_strided_dim() const noexcept {
+    int32_t dim = -1;
+    for (int32_t j = 0; j < m_subdims; ++j)
+      dim = std::max(dim, m_offsets[j]);
+    return dim;
+  }
+  /// Return the extent of a dimension, numbered as in outer_strided_dim().
+  constexpr scipp::index extent(const int32_t dim) const noexcept {
+    return m_extent[dim];
+  }
+
 private:
   // NOTE:
   // We investigated different containers for the m_delta, m_coord & m_extent
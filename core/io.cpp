@@ -0,0 +1,540 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "scipp/core/io.h"
+
+namespace scipp::core::io {
+
+namespace {
+constexpr std::array<char, 8> magic{'s', 'c', 'i', 'p', 'p', 'b', 'i', 'n'};
+constexpr int64_t version = 1;
+/// Alignment of buffers relative to the start of the file. Mapped files start
+/// at a page boundary, so buffers can be used in place.
+constexpr int64_t alignment = 64;
+/// Elements per write when copying a (potentially strided) buffer to file.
+constexpr scipp::index chunk_size = 1 << 16;
+
+constexpr int64_t num_units =
+    std::tuple_size_v<units::supported_units_t<units::Unit>>;
+
+enum class Tag : int64_t { Variable, DataArray, Dataset, PackedEvents };
+
+template <class T> struct type_tag { using type = T; };
+
+/// Call `func` with a type_tag for the element type given by `type`.
+template <class Func> decltype(auto) visit_dtype(const DType type, Func func) {
+  switch (type) {
+  case dtype<double>:
+    return func(type_tag<double>{});
+  case dtype<float>:
+    return func(type_tag<float>{});
+  case dtype<int64_t>:
+    return func(type_tag<int64_t>{});
+  case dtype<int32_t>:
+    return func(type_tag<int32_t>{});
+  case dtype<bool>:
+    return func(type_tag<bool>{});
+  case dtype<Eigen::Vector3d>:
+    return func(type_tag<Eigen::Vector3d>{});
+  case dtype<std::string>:
+    return func(type_tag<std::string>{});
+  case dtype<DataArray>:
+    return func(type_tag<DataArray>{});
+  case dtype<Dataset>:
+    return func(type_tag<Dataset>{});
+  default:
+    throw except::TypeError("Cannot save or load variable with dtype " +
+                            to_string(type) + ".");
+  }
+}
+
+/// True if elements of type T are stored as raw bytes that can be used in
+/// place after mapping the file.
+template <class T>
+constexpr bool is_raw = std::is_arithmetic_v<T> ||
+                        std::is_same_v<T, Eigen::Vector3d>;
+
+/// Read-only file mapped into memory with private copy-on-write pages.
+///
+/// Data is read from disk only when a page is first accessed. Writes to the
+/// mapped memory are private, i.e., they do not modify the file.
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &filename) {
+#ifdef _WIN32
+    // No mmap, fall back to reading the entire file.
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file)
+      throw except::FileError("Cannot open `" + filename + "`.");
+    m_size = file.tellg();
+    m_buffer = std::make_unique<char[]>(m_size);
+    file.seekg(0);
+    if (!file.read(m_buffer.get(), m_size))
+      throw except::FileError("Failed to read `" + filename + "`.");
+    m_data = m_buffer.get();
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+      throw except::FileError("Cannot open `" + filename +
+                              "`: " + std::strerror(errno));
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+      ::close(fd);
+      throw except::FileError("Cannot stat `" + filename +
+                              "`: " + std::strerror(errno));
+    }
+    m_size = status.st_size;
+    if (m_size > 0) {
+      void *data = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        ::close(fd);
+        throw except::FileError("Cannot map `" + filename +
+                                "`: " + std::strerror(errno));
+      }
+      m_data = static_cast<char *>(data);
+    }
+    // The mapping keeps the file open.
+    ::close(fd);
+#endif
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() {
+#ifndef _WIN32
+    if (m_data)
+      ::munmap(m_data, m_size);
+#endif
+  }
+
+  char *data() const noexcept { return m_data; }
+  scipp::index size() const noexcept { return m_size; }
+
+private:
+  char *m_data{nullptr};
+  scipp::index m_size{0};
+#ifdef _WIN32
+  std::unique_ptr<char[]> m_buffer;
+#endif
+};
+
+class Writer {
+public:
+  explicit Writer(const std::string &filename)
+      : m_file(filename, std::ios::binary | std::ios::trunc) {
+    if (!m_file)
+      throw except::FileError("Cannot open `" + filename + "` for writing.");
+    write_bytes(magic.data(), magic.size());
+    write(version);
+  }
+
+  void close(const std::string &filename) {
+    m_file.close();
+    if (!m_file)
+      throw except::FileError("Failed to write `" + filename + "`.");
+  }
+
+  template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+  void write(const T value) {
+    write_bytes(&value, sizeof(T));
+  }
+  void write(const Tag tag) { write(static_cast<int64_t>(tag)); }
+  void write(const Dim dim) { write(static_cast<int64_t>(dim)); }
+  void write(const units::Unit unit) { write(int64_t{unit.index()}); }
+  void write(const std::string &string) {
+    write(int64_t{scipp::size(string)});
+    write_bytes(string.data(), string.size());
+  }
+
+  void write(const Dimensions &dims) {
+    write(int64_t{dims.ndim()});
+    for (const auto dim : dims.labels()) {
+      write(dim);
+      write(int64_t{dims[dim]});
+    }
+  }
+
+  void write(const VariableConstView &var) {
+    write(static_cast<int64_t>(var.dtype()));
+    const bool sparse = var.dims().sparse();
+    write(int64_t{sparse});
+    if (sparse)
+      return write(sparse::pack(var));
+    write(var.unit());
+    write(var.dims());
+    write(int64_t{var.hasVariances()});
+    visit_dtype(var.dtype(), [&](const auto tag) {
+      using T = typename decltype(tag)::type;
+      write_elements(var.template values<T>());
+      if (var.hasVariances())
+        write_elements(var.template variances<T>());
+    });
+  }
+
+  void write(const PackedEvents &events) {
+    const auto begin = events.begin().values<scipp::index>();
+    const auto end = events.end().values<scipp::index>();
+    scipp::index used = 0;
+    for (scipp::index i = 0; i < scipp::size(begin); ++i)
+      used += end[i] - begin[i];
+    // Do not store events outside the ranges, e.g., for a slice.
+    if (used != events.buffer().dims().volume())
+      return write(copy(events));
+    write(events.begin());
+    write(events.end());
+    write(events.buffer());
+  }
+
+  void write(const DataArrayConstView &array) {
+    write(array.name());
+    write(int64_t{array.hasData()});
+    if (array.hasData())
+      write(array.data());
+    write_items(array.coords());
+    write_items(array.labels());
+    write_items(array.masks());
+    write_items(array.attrs());
+  }
+
+  void write(const DatasetConstView &dataset) {
+    write_items(dataset.coords());
+    write_items(dataset.labels());
+    write_items(dataset.masks());
+    write_items(dataset.attrs());
+    write(int64_t{dataset.size()});
+    const auto is_sparse = [](const auto &var) { return var.dims().sparse(); };
+    for (const auto &item : dataset) {
+      write(item.name());
+      write(int64_t{item.hasData()});
+      if (item.hasData())
+        write(item.data());
+      // Only the sparse coord and labels belong to the item, the others are
+      // stored with the dataset.
+      write_items(item.coords(), is_sparse);
+      write_items(item.labels(), is_sparse);
+      write_items(item.attrs());
+    }
+  }
+
+private:
+  void write_bytes(const void *data, const scipp::index size) {
+    m_file.write(static_cast<const char *>(data), size);
+    m_offset += size;
+  }
+
+  void pad() {
+    constexpr std::array<char, alignment> zeros{};
+    write_bytes(zeros.data(), (alignment - m_offset % alignment) % alignment);
+  }
+
+  template <class View> void write_elements(const View &data) {
+    using T = std::remove_const_t<typename View::value_type>;
+    const auto size = scipp::size(data);
+    if constexpr (is_raw<T>) {
+      pad();
+      const auto buffer = std::make_unique<T[]>(std::min(size, chunk_size));
+      auto it = data.begin();
+      for (scipp::index i = 0; i < size; i += chunk_size) {
+        const auto n = std::min(chunk_size, size - i);
+        for (scipp::index j = 0; j < n; ++j, ++it)
+          buffer[j] = *it;
+        write_bytes(buffer.get(), n * sizeof(T));
+      }
+    } else if constexpr (std::is_same_v<T, DataArray>) {
+      for (const auto &item : data)
+        write(DataArrayConstView(item));
+    } else if constexpr (std::is_same_v<T, Dataset>) {
+      for (const auto &item : data)
+        write(DatasetConstView(item));
+    } else {
+      for (const auto &item : data)
+        write(item);
+    }
+  }
+
+  template <class Items> void write_items(const Items &items) {
+    write_items(items, [](const auto &) { return true; });
+  }
+
+  template <class Items, class Predicate>
+  void write_items(const Items &items, Predicate predicate) {
+    std::vector<std::pair<typename Items::key_type, VariableConstView>>
+        selected;
+    for (const auto &[key, var] : items)
+      if (predicate(var))
+        selected.emplace_back(key, var);
+    write(int64_t{scipp::size(selected)});
+    for (const auto &[key, var] : selected) {
+      write(key);
+      write(var);
+    }
+  }
+
+  std::ofstream m_file;
+  scipp::index m_offset{0};
+};
+
+class Reader {
+public:
+  explicit Reader(const std::string &filename)
+      : m_filename(filename), m_file(std::make_shared<MappedFile>(filename)) {
+    check(magic.size());
+    if (!std::equal(magic.begin(), magic.end(), m_file->data()))
+      throw except::FileError("`" + filename + "` is not a scipp file.");
+    m_offset += magic.size();
+    if (read<int64_t>() != version)
+      throw except::FileError("`" + filename +
+                              "` was written by an incompatible version "
+                              "of scipp.");
+  }
+
+  Object read_object() {
+    switch (read<Tag>()) {
+    case Tag::Variable:
+      return read_variable();
+    case Tag::DataArray:
+      return read_data_array();
+    case Tag::Dataset:
+      return read_dataset();
+    case Tag::PackedEvents:
+      return read_events();
+    default:
+      throw corrupt();
+    }
+  }
+
+private:
+  except::FileError corrupt() const {
+    return except::FileError("`" + m_filename + "` is corrupt.");
+  }
+
+  void check(const scipp::index size) const {
+    if (size < 0 || m_offset + size > m_file->size())
+      throw corrupt();
+  }
+
+  template <class T> T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    check(sizeof(T));
+    T value;
+    std::copy_n(m_file->data() + m_offset, sizeof(T),
+                reinterpret_cast<char *>(&value));
+    m_offset += sizeof(T);
+    return value;
+  }
+
+  scipp::index read_size() {
+    const auto size = read<int64_t>();
+    if (size < 0)
+      throw corrupt();
+    return size;
+  }
+
+  std::string read_string() {
+    const auto size = read_size();
+    check(size);
+    std::string string(m_file->data() + m_offset, size);
+    m_offset += size;
+    return string;
+  }
+
+  Dim read_dim() {
+    const auto dim = read<int64_t>();
+    if (dim < 0 || dim >= static_cast<int64_t>(Dim::Invalid))
+      throw corrupt();
+    return static_cast<Dim>(dim);
+  }
+
+  units::Unit read_unit() {
+    const auto index = read<int64_t>();
+    if (index < 0 || index >= num_units)
+      throw corrupt();
+    return units::Unit::fromIndex(index);
+  }
+
+  Dimensions read_dims() {
+    const auto ndim = read_size();
+    if (ndim > NDIM_MAX)
+      throw corrupt();
+    std::vector<Dim> labels;
+    std::vector<scipp::index> shape;
+    for (scipp::index i = 0; i < ndim; ++i) {
+      labels.push_back(read_dim());
+      shape.push_back(read_size());
+    }
+    return Dimensions(labels, shape);
+  }
+
+  template <class T> auto read_elements(const scipp::index size) {
+    if constexpr (is_raw<T>) {
+      m_offset += (alignment - m_offset % alignment) % alignment;
+      check(size * sizeof(T));
+      auto *data = static_cast<T *>(
+          static_cast<void *>(m_file->data() + m_offset));
+      m_offset += size * sizeof(T);
+      // Use the mapped memory in place, the array keeps the mapping alive.
+      return detail::element_array<T>(data, size, m_file);
+    } else {
+      detail::element_array<T> elements(size);
+      for (auto *item = elements.data(); item != elements.data() + size;
+           ++item) {
+        if constexpr (std::is_same_v<T, DataArray>)
+          *item = read_data_array();
+        else if constexpr (std::is_same_v<T, Dataset>)
+          *item = read_dataset();
+        else
+          *item = read_string();
+      }
+      return elements;
+    }
+  }
+
+  Variable read_variable() {
+    const auto type = static_cast<DType>(read<int64_t>());
+    if (read<int64_t>() != 0)
+      return sparse::unpack(read_events());
+    const auto unit = read_unit();
+    const auto dims = read_dims();
+    const bool variances = read<int64_t>() != 0;
+    return visit_dtype(type, [&](const auto tag) {
+      using T = typename decltype(tag)::type;
+      auto values = read_elements<T>(dims.volume());
+      if (!variances)
+        return Variable(unit, dims, std::move(values));
+      auto vars = read_elements<T>(dims.volume());
+      return Variable(unit, dims, std::move(values), std::move(vars));
+    });
+  }
+
+  PackedEvents read_events() {
+    auto begin = read_variable();
+    auto end = read_variable();
+    auto buffer = read_variable();
+    return PackedEvents(std::move(begin), std::move(end), std::move(buffer));
+  }
+
+  template <class Key> std::map<Key, Variable> read_items() {
+    std::map<Key, Variable> items;
+    const auto size = read_size();
+    for (scipp::index i = 0; i < size; ++i) {
+      Key key;
+      if constexpr (std::is_same_v<Key, Dim>)
+        key = read_dim();
+      else
+        key = read_string();
+      items.emplace(std::move(key), read_variable());
+    }
+    return items;
+  }
+
+  DataArray read_data_array() {
+    auto name = read_string();
+    std::optional<Variable> data;
+    if (read<int64_t>() != 0)
+      data = read_variable();
+    auto coords = read_items<Dim>();
+    auto labels = read_items<std::string>();
+    auto masks = read_items<std::string>();
+    auto attrs = read_items<std::string>();
+    return DataArray(std::move(data), std::move(coords), std::move(labels),
+                     std::move(masks), std::move(attrs), name);
+  }
+
+  Dataset read_dataset() {
+    Dataset dataset;
+    for (auto &&[dim, coord] : read_items<Dim>())
+      dataset.setCoord(dim, std::move(coord));
+    for (auto &&[name, labels] : read_items<std::string>())
+      dataset.setLabels(name, std::move(labels));
+    for (auto &&[name, mask] : read_items<std::string>())
+      dataset.setMask(name, std::move(mask));
+    for (auto &&[name, attr] : read_items<std::string>())
+      dataset.setAttr(name, std::move(attr));
+    const auto size = read_size();
+    for (scipp::index i = 0; i < size; ++i) {
+      const auto name = read_string();
+      if (read<int64_t>() != 0)
+        dataset.setData(name, read_variable());
+      for (auto &&[dim, coord] : read_items<Dim>())
+        dataset.setSparseCoord(name, std::move(coord));
+      for (auto &&[labelName, labels] : read_items<std::string>())
+        dataset.setSparseLabels(name, labelName, std::move(labels));
+      for (auto &&[attrName, attr] : read_items<std::string>())
+        dataset.setAttr(name, attrName, std::move(attr));
+    }
+    return dataset;
+  }
+
+  std::string m_filename;
+  std::shared_ptr<MappedFile> m_file;
+  scipp::index m_offset{0};
+};
+
+template <class T>
+void save_impl(const T &object, const std::string &filename, const Tag tag) {
+  // Write to a temporary file and rename it, such that objects loaded from an
+  // existing file of the same name keep their mapping of the old content.
+  const auto tmp = filename + ".tmp";
+  try {
+    Writer writer(tmp);
+    writer.write(tag);
+    writer.write(object);
+    writer.close(tmp);
+  } catch (...) {
+    std::remove(tmp.c_str());
+    throw;
+  }
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    // Renaming does not replace existing files on all platforms.
+    std::remove(filename.c_str());
+    if (std::rename(tmp.c_str(), filename.c_str()) != 0)
+      throw except::FileError("Failed to write `" + filename + "`.");
+  }
+}
+} // namespace
+
+void save(const VariableConstView &var, const std::string &filename) {
+  save_impl(var, filename, Tag::Variable);
+}
+
+void save(const DataArrayConstView &array, const std::string &filename) {
+  save_impl(array, filename, Tag::DataArray);
+}
+
+void save(const DatasetConstView &dataset, const std::string &filename) {
+  save_impl(dataset, filename, Tag::Dataset);
+}
+
+void save(const PackedEvents &events, const std::string &filename) {
+  save_impl(events, filename, Tag::PackedEvents);
+}
+
+/// Load a file written by `save`.
+///
+/// Dense variables and packed events reference the mapped file, i.e., their
+/// data is read on first access. Modifying them does not modify the file.
+Object load(const std::string &filename) {
+  return Reader(filename).read_object();
+}
+
+} // namespace scipp::core::io
@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+/// @author Simon Heybrock
+#include <algorithm>
+#include <utility>
+
+#include "scipp/core/except.h"
+#include "scipp/core/packed_events.h"
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
+
+namespace scipp::core {
+
+namespace {
+using EventTypes = CallDType<double, float, int64_t, int32_t>;
+
+/// Copy [first, last) to `out` in parallel chunks.
+template <class T> void parallel_copy(const T *first, const T *last, T *out) {
+  parallel::parallel_for(parallel::blocked_range(0, last - first),
+                         [&](const auto &range) {
+                           std::copy(first + range.begin(), first + range.end(),
+                                     out + range.begin());
+                         });
+}
+
+/// Copy ranges [begin[i], end[i]) of `in` to `out`, starting at `out_begin[i]`.
+template <class T>
+void copy_ranges(const scipp::span<const scipp::index> &begin,
+                 const scipp::span<const scipp::index> &end,
+                 const scipp::span<const scipp::index> &out_begin, const T *in,
+                 T *out) {
+  parallel::parallel_for(parallel::blocked_range(0, scipp::size(begin)),
+                         [&](const auto &range) {
+                           for (auto i = range.begin(); i != range.end(); ++i)
+                             std::copy(in + begin[i], in + end[i],
+                                       out + out_begin[i]);
+                         });
+}
+
+/// Return uninitialized event buffer with `size` events and the same
+/// dimension, unit, and presence of variances as `prototype`.
+template <class T>
+Variable make_buffer(const Variable &prototype, const scipp::index size) {
+  const auto dim = prototype.dims().inner();
+  return prototype.hasVariances()
+             ? makeVariable<T>(Dims{dim}, Shape{size}, prototype.unit(),
+                               Values{}, Variances{})
+             : makeVariable<T>(Dims{dim}, Shape{size}, prototype.unit());
+}
+
+/// Set `begin` and `end` to consecutive ranges of given sizes, return total.
+scipp::index set_ranges(const scipp::span<scipp::index> &begin,
+                        const scipp::span<scipp::index> &end,
+                        const scipp::span<const scipp::index> &sizes) {
+  scipp::index total = 0;
+  for (scipp::index i = 0; i < scipp::size(sizes); ++i) {
+    begin[i] = total;
+    total += sizes[i];
+    end[i] = total;
+  }
+  return total;
+}
+
+template <class T> struct Pack {
+  static PackedEvents apply(const VariableConstView &var) {
+    const auto counts = sparse::counts(var);
+    Variable begin(counts);
+    begin.setUnit(units::dimensionless);
+    Variable end(begin);
+    const auto total =
+        set_ranges(begin.values<scipp::index>(), end.values<scipp::index>(),
+                   counts.values<scipp::index>());
+    const auto dims = var.dims();
+    Variable buffer =
+        var.hasVariances()
+            ? makeVariable<T>(Dims{dims.sparseDim()}, Shape{total},
+                              var.unit(), Values{}, Variances{})
+            : makeVariable<T>(Dims{dims.sparseDim()}, Shape{total},
+                              var.unit());
+    const auto offsets = std::as_const(begin).values<scipp::index>();
+    const auto pack = [&](const auto &in, const auto &out) {
+      parallel::parallel_for(
+          parallel::blocked_range(0, scipp::size(offsets)),
+          [&](const auto &range) {
+            auto it = in.begin() + range.begin();
+            for (auto i = range.begin(); i != range.end(); ++i, ++it)
+              std::copy(it->begin(), it->end(), out.begin() + offsets[i]);
+          });
+    };
+    pack(var.sparseValues<T>(), buffer.values<T>());
+    if (var.hasVariances())
+      pack(var.sparseVariances<T>(), buffer.variances<T>());
+    return {std::move(begin), std::move(end), std::move(buffer)};
+  }
+};
+
+template <class T> struct Unpack {
+  static Variable apply(const PackedEvents &events) {
+    Variable out = events.hasVariances()
+                       ? makeVariable<T>(Dimensions{events.dims()},
+                                         events.unit(), Values{}, Variances{})
+                       : makeVariable<T>(Dimensions{events.dims()},
+                                         events.unit());
+    const auto begin = events.begin().values<scipp::index>();
+    const auto end = events.end().values<scipp::index>();
+    const auto unpack = [&](const auto &in, const auto &out_) {
+      parallel::parallel_for(
+          parallel::blocked_range(0, scipp::size(begin)),
+          [&](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+              out_[i].assign(in.begin() + begin[i], in.begin() + end[i]);
+          });
+    };
+    unpack(events.buffer().values<T>(), out.sparseValues<T>());
+    if (events.hasVariances())
+      unpack(events.buffer().variances<T>(), out.sparseVariances<T>());
+    return out;
+  }
+};
+
+template <class T> struct Copy {
+  static PackedEvents apply(const PackedEvents &events) {
+    const auto begin = events.begin().values<scipp::index>();
+    const auto end = events.end().values<scipp::index>();
+    Variable outBegin(events.begin());
+    Variable outEnd(events.end());
+    std::vector<scipp::index> sizes(begin.size());
+    bool contiguous = true;
+    for (scipp::index i = 0; i < scipp::size(begin); ++i) {
+      sizes[i] = end[i] - begin[i];
+      contiguous &= i == 0 || begin[i] == end[i - 1];
+    }
+    const auto total = set_ranges(outBegin.values<scipp::index>(),
+                                  outEnd.values<scipp::index>(), sizes);
+    Variable buffer = make_buffer<T>(events.buffer(), total);
+    const auto copy_data = [&](const auto &in, const auto &out) {
+      // Unsliced events and slices of the outer dimension are a single range.
+      if (contiguous && !begin.empty())
+        parallel_copy(in.data() + begin[0], in.data() + begin[0] + total,
+                      out.data());
+      else
+        copy_ranges(begin, end,
+                    std::as_const(outBegin).values<scipp::index>(), in.data(),
+                    out.data());
+    };
+    copy_data(events.buffer().values<T>(), buffer.values<T>());
+    if (events.hasVariances())
+      copy_data(events.buffer().variances<T>(), buffer.variances<T>());
+    return {std::move(outBegin), std::move(outEnd), std::move(buffer)};
+  }
+};
+
+template <class T> struct Flatten {
+  static Variable apply(const PackedEvents &events, const Variable &begin,
+                        const Variable &end, const Variable &outBegin,
+                        const scipp::index extent, const scipp::index total) {
+    const auto b = begin.values<scipp::index>();
+    const auto e = end.values<scipp::index>();
+    const auto ob = outBegin.values<scipp::index>();
+    Variable buffer = make_buffer<T>(events.buffer(), total);
+    const auto flatten = [&](const auto &in, const auto &out) {
+      parallel::parallel_for(
+          parallel::blocked_range(0, scipp::size(ob)), [&](const auto &range) {
+            for (auto o = range.begin(); o != range.end(); ++o) {
+              auto it = out.begin() + ob[o];
+              for (auto i = o * extent; i < (o + 1) * extent; ++i)
+                it = std::copy(in.begin() + b[i], in.begin() + e[i], it);
+            }
+          });
+    };
+    flatten(events.buffer().values<T>(), buffer.values<T>());
+    if (events.hasVariances())
+      flatten(events.buffer().variances<T>(), buffer.variances<T>());
+    return buffer;
+  }
+};
+
+template <class T> struct MakeView {
+  static Variable apply(const PackedEvents &events) {
+    const auto begin = events.begin().values<scipp::index>();
+    const auto end = events.end().values<scipp::index>();
+    const auto spans = [&](const auto &data) {
+      std::vector<span<const T>> out(begin.size());
+      for (scipp::index i = 0; i < scipp::size(begin); ++i)
+        out[i] = data.subspan(begin[i], end[i] - begin[i]);
+      return out;
+    };
+    const auto &dims = events.begin().dims();
+    const auto &buffer = events.buffer();
+    if (events.hasVariances())
+      return makeVariable<span<const T>>(
+          Dimensions{dims}, events.unit(), Values(spans(buffer.values<T>())),
+          Variances(spans(buffer.variances<T>())));
+    return makeVariable<span<const T>>(Dimensions{dims}, events.unit(),
+                                       Values(spans(buffer.values<T>())));
+  }
+};
+
+template <class T> struct Equal {
+  static bool apply(const PackedEvents &a, const PackedEvents &b) {
+    const auto equal = [&](const auto &dataA, const auto &dataB) {
+      const auto beginA = a.begin().values<scipp::index>();
+      const auto endA = a.end().values<scipp::index>();
+      const auto beginB = b.begin().values<scipp::index>();
+      const auto endB = b.end().values<scipp::index>();
+      for (scipp::index i = 0; i < scipp::size(beginA); ++i)
+        if (!std::equal(dataA.begin() + beginA[i], dataA.begin() + endA[i],
+                        dataB.begin() + beginB[i], dataB.begin() + endB[i]))
+          return false;
+      return true;
+    };
+    return equal(a.buffer().values<T>(), b.buffer().values<T>()) &&
+           (!a.hasVariances() ||
+            equal(a.buffer().variances<T>(), b.buffer().variances<T>()));
+  }
+};
+} // namespace
+
+PackedEvents::PackedEvents(Variable begin, Variable end, Variable buffer)
+    : m_begin(std::move(begin)), m_end(std::move(end)),
+      m_buffer(std::make_shared<const Variable>(std::move(buffer))) {
+  if (m_begin.dtype() != core::dtype<scipp::index> ||
+      m_end.dtype() != core::dtype<scipp::index>)
+    throw except::TypeError("Event list ranges must have dtype int64.");
+  if (m_begin.hasVariances() || m_end.hasVariances())
+    throw except::VariancesError("Event list ranges cannot have variances.");
+  expect::notSparse(m_begin);
+  expect::equals(m_begin.dims(), m_end.dims());
+  const auto &bufferDims = this->buffer().dims();
+  if (bufferDims.ndim() != 1 || bufferDims.sparse() ||
+      m_begin.dims().contains(bufferDims.inner()))
+    throw except::DimensionError("Event buffer must be 1-dimensional, with a "
+                                 "dimension not used by the event lists.");
+  const auto size = bufferDims.volume();
+  const auto b = std::as_const(m_begin).values<scipp::index>();
+  const auto e = std::as_const(m_end).values<scipp::index>();
+  for (scipp::index i = 0; i < scipp::size(b); ++i)
+    if (b[i] < 0 || b[i] > e[i] || e[i] > size)
+      throw except::SliceError("Event list range out of bounds of buffer.");
+}
+
+/// Return the dimensions of the event lists, with the dimension of the
+/// buffer as the sparse dimension.
+Dimensions PackedEvents::dims() const {
+  auto dims = m_begin.dims();
+  dims.addInner(buffer().dims().inner(), Dimensions::Sparse);
+  return dims;
+}
+
+/// Return slice of the event lists. The buffer is shared, not copied.
+PackedEvents PackedEvents::slice(const Slice slice) const {
+  PackedEvents sliced(*this);
+  sliced.m_begin = Variable(m_begin.slice(slice));
+  sliced.m_end = Variable(m_end.slice(slice));
+  return sliced;
+}
+
+/// Return a variable with a span of events for each element.
+///
+/// This supports processing events using `transform` and
+/// `transform_subspan`. The returned variable references the buffer, i.e.,
+/// *this must outlive it.
+Variable PackedEvents::view() const {
+  return CallDType<double, float>::apply<MakeView>(dtype(), *this);
+}
+
+bool PackedEvents::operator==(const PackedEvents &other) const {
+  if (dims() != other.dims() || dtype() != other.dtype() ||
+      unit() != other.unit() || hasVariances() != other.hasVariances())
+    return false;
+  const auto sizes = [](const PackedEvents &events) {
+    return events.end() - events.begin();
+  };
+  if (sizes(*this) != sizes(other))
+    return false;
+  return EventTypes::apply<Equal>(dtype(), *this, other);
+}
+
+bool PackedEvents::operator!=(const PackedEvents &other) const {
+  return !(*this == other);
+}
+
+/// Return a deep copy of `events`, with a compact buffer.
+///
+/// The buffer of the copy only contains events referenced by `events`, in
+/// order of the elements. If the event lists are a contiguous range of the
+/// buffer, as after packing or copying, this is a single parallel copy.
+PackedEvents copy(const PackedEvents &events) {
+  return EventTypes::apply<Copy>(events.dtype(), events);
+}
+
+/// Flatten dimension `dim` by concatenating the event lists along `dim`.
+///
+/// This is equivalent to `flatten` for sparse variables.
+PackedEvents flatten(const PackedEvents &events, const Dim dim) {
+  const auto &dims = events.begin().dims();
+  if (!dims.contains(dim))
+    throw except::DimensionNotFoundError(dims, dim);
+  // Transposed copies of the ranges, such that `dim` is the inner dimension.
+  std::vector<Dim> order;
+  for (const auto label : dims.labels())
+    if (label != dim)
+      order.push_back(label);
+  order.push_back(dim);
+  const Variable begin(events.begin().transpose(order));
+  const Variable end(events.end().transpose(order));
+  const auto extent = dims[dim];
+
+  auto outDims = dims;
+  outDims.erase(dim);
+  auto outBegin = makeVariable<scipp::index>(Dimensions{outDims});
+  auto outEnd = makeVariable<scipp::index>(Dimensions{outDims});
+  std::vector<scipp::index> sizes(outDims.volume());
+  const auto b = begin.values<scipp::index>();
+  const auto e = end.values<scipp::index>();
+  for (scipp::index o = 0; o < scipp::size(sizes); ++o)
+    for (auto i = o * extent; i < (o + 1) * extent; ++i)
+      sizes[o] += e[i] - b[i];
+  const auto total = set_ranges(outBegin.values<scipp::index>(),
+                                outEnd.values<scipp::index>(), sizes);
+  auto buffer = EventTypes::apply<Flatten>(events.dtype(), events, begin, end,
+                                           outBegin, extent, total);
+  return {std::move(outBegin), std::move(outEnd), std::move(buffer)};
+}
+
+namespace sparse {
+/// Return packed copy of the events of the sparse variable `var`.
+PackedEvents pack(const VariableConstView &var) {
+  if (!var.dims().sparse())
+    throw except::DimensionError("Expected sparse data.");
+  return EventTypes::apply<Pack>(var.dtype(), var);
+}
+
+/// Return sparse variable with a copy of the events of `events`.
+Variable unpack(const PackedEvents &events) {
+  return EventTypes::apply<Unpack>(events.dtype(), events);
+}
+
+/// Return packed events with event list `i` given by the range
+/// [offsets[i], offsets[i + 1]) of `buffer`.
+///
+/// This is the compressed sparse row format used by most event file formats,
+/// i.e., event data can be loaded in bulk instead of one event list at a time.
+PackedEvents from_offsets(const VariableConstView &offsets, Variable buffer) {
+  const auto &dims = offsets.dims();
+  if (dims.ndim() != 1 || dims.sparse())
+    throw except::DimensionError("Event list offsets must be 1-dimensional.");
+  const auto dim = dims.inner();
+  if (dims[dim] == 0)
+    throw except::SizeError("Event list offsets must not be empty.");
+  const auto size = dims[dim] - 1;
+  return {Variable(offsets.slice({dim, 0, size})),
+          Variable(offsets.slice({dim, 1, size + 1})), std::move(buffer)};
+}
+
+/// Return the offsets of the event lists in the buffer of 1-D `events`.
+///
+/// This is the inverse of `from_offsets`. If the event lists are not stored
+/// consecutively in the buffer, as after slicing, use `copy` first.
+Variable offsets(const PackedEvents &events) {
+  const auto &dims = events.begin().dims();
+  if (dims.ndim() != 1)
+    throw except::DimensionError("Offsets require 1-dimensional event lists.");
+  const auto dim = dims.inner();
+  const auto begin = events.begin().values<scipp::index>();
+  const auto end = events.end().values<scipp::index>();
+  auto offsets = makeVariable<scipp::index>(Dims{dim}, Shape{dims[dim] + 1});
+  auto out = offsets.values<scipp::index>();
+  out[0] = 0;
+  for (scipp::index i = 0; i < scipp::size(begin); ++i) {
+    if (begin[i] != out[i])
+      throw except::SliceError(
+          "Event lists are not stored consecutively in the buffer.");
+    out[i + 1] = end[i];
+  }
+  return offsets;
+}
+} // namespace sparse
+
+} // namespace scipp::core
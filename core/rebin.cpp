@@ -2,8 +2,14 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock, Igor Gudich
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <vector>
+
 #include "scipp/core/apply.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/variable.h"
 #include "scipp/units/except.h"
 
@@ -16,104 +22,272 @@ bool isBinEdge(const Dim dim, Dimensions edges, const Dimensions &toMatch) {
 
 bool is1D(Dimensions edges) { return edges.shape().size() == 1; }
 
+/// Return true if `edges` are 1D or have the dimensions of `data`, with
+/// bin-edges along `dim`.
+bool is1DOrMatching(const Dim dim, Dimensions edges, const Dimensions &data) {
+  if (is1D(edges))
+    return true;
+  edges.resize(dim, edges[dim] - 1);
+  return edges == data;
+}
+
+namespace rebin_detail {
+/// Walk old and new bins and call `func(iold, inew, fraction)` for every pair
+/// of overlapping bins, where `fraction` is the overlap relative to the width
+/// of the old bin. Edges are accessed with the given stride.
+template <class OldEdge, class NewEdge, class Func>
+void for_each_overlap(const OldEdge *xold, const scipp::index oldSize,
+                      const NewEdge *xnew, const scipp::index newSize,
+                      const scipp::index stride, Func func) {
+  scipp::index iold = 0;
+  scipp::index inew = 0;
+  while ((iold < oldSize) && (inew < newSize)) {
+    const auto xo_low = xold[iold * stride];
+    const auto xo_high = xold[(iold + 1) * stride];
+    const auto xn_low = xnew[inew * stride];
+    const auto xn_high = xnew[(inew + 1) * stride];
+
+    if (xn_high <= xo_low)
+      inew++; /* old and new bins do not overlap */
+    else if (xo_high <= xn_low)
+      iold++; /* old and new bins do not overlap */
+    else {
+      // delta is the overlap of the bins on the x axis
+      const auto delta = std::min<double>(xn_high, xo_high) -
+                         std::max<double>(xn_low, xo_low);
+      const auto owidth = xo_high - xo_low;
+      func(iold, inew, delta / owidth);
+      if (xn_high > xo_high) {
+        iold++;
+      } else {
+        inew++;
+      }
+    }
+  }
+}
+
+/// Overlap matrix of old and new bins in compressed sparse row format. New
+/// bin `inew` receives `weights[k]` times old bin `old_bins[k]` for all `k` in
+/// [offsets[inew], offsets[inew + 1]).
+struct Overlap {
+  Overlap(const double *xold, const scipp::index oldSize, const double *xnew,
+          const scipp::index newSize)
+      : offsets(newSize + 1) {
+    for_each_overlap(xold, oldSize, xnew, newSize, 1,
+                     [this](const auto iold, const auto inew, const auto w) {
+                       ++offsets[inew + 1];
+                       old_bins.push_back(iold);
+                       weights.push_back(w);
+                     });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  }
+
+  std::vector<scipp::index> offsets;
+  std::vector<scipp::index> old_bins;
+  std::vector<double> weights;
+};
+
+/// Add `in` scaled by `weight` to `out`. Masks are combined with OR.
+template <class T>
+void add_scaled(T *out, const T *in, const double weight,
+                const scipp::index size) {
+  if constexpr (std::is_same_v<T, bool>) {
+    if (weight > 0)
+      for (scipp::index i = 0; i < size; ++i)
+        out[i] = out[i] || in[i];
+  } else {
+    const auto w = static_cast<T>(weight);
+    for (scipp::index i = 0; i < size; ++i)
+      out[i] += in[i] * w;
+  }
+}
+
+/// Return the edges in `coord` converted to double and broadcast to `dims`.
+std::vector<double> get_edges(const VariableConstView &coord,
+                              const Dimensions &dims) {
+  if (!dims.contains(coord.dims()))
+    throw except::DimensionError(
+        "Bin edges must not depend on dimensions that the data does not "
+        "depend on.");
+  const auto copy = [&dims](const auto &data) {
+    const auto view = data.valuesView(dims);
+    return std::vector<double>(view.begin(), view.end());
+  };
+  switch (coord.dtype()) {
+  case dtype<double>:
+    return copy(static_cast<const VariableConceptT<double> &>(coord.data()));
+  case dtype<float>:
+    return copy(static_cast<const VariableConceptT<float> &>(coord.data()));
+  default:
+    throw std::runtime_error(
+        "Rebinning is possible only for double and float types.");
+  }
+}
+
+/// Rebin where the edges depend only on `dim` and outer dimensions. For every
+/// outer index the old rows of length `inner` are contracted with the overlap
+/// matrix. Work is parallel over new rows.
+template <class T>
+void rebin_rows(const T *old, T *out, const scipp::index outer,
+                const scipp::index oldSize, const scipp::index newSize,
+                const scipp::index inner,
+                const std::vector<Overlap> &overlaps) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, outer * newSize), [&](const auto &range) {
+        for (auto row = range.begin(); row < range.end(); ++row) {
+          const auto o = row / newSize;
+          const auto inew = row % newSize;
+          const auto &overlap = overlaps[overlaps.size() == 1 ? 0 : o];
+          for (auto k = overlap.offsets[inew]; k < overlap.offsets[inew + 1];
+               ++k)
+            add_scaled(out + row * inner,
+                       old + (o * oldSize + overlap.old_bins[k]) * inner,
+                       overlap.weights[k], inner);
+        }
+      });
+}
+
+/// Rebin where the edges depend on inner dimensions. Every column, i.e., every
+/// combination of outer and inner index, is rebinned with its own edges,
+/// given with a stride of `inner`. Work is parallel over columns.
+template <class T>
+void rebin_columns(const T *old, T *out, const scipp::index outer,
+                   const scipp::index oldSize, const scipp::index newSize,
+                   const scipp::index inner, const std::vector<double> &xold,
+                   const std::vector<double> &xnew) {
+  parallel::parallel_for(
+      parallel::blocked_range(0, outer * inner), [&](const auto &range) {
+        for (auto column = range.begin(); column < range.end(); ++column) {
+          const auto o = column / inner;
+          const auto i = column % inner;
+          for_each_overlap(
+              xold.data() + o * (oldSize + 1) * inner + i, oldSize,
+              xnew.data() + o * (newSize + 1) * inner + i, newSize, inner,
+              [&](const auto iold, const auto inew, const auto w) {
+                add_scaled(out + (o * newSize + inew) * inner + i,
+                           old + (o * oldSize + iold) * inner + i, w, 1);
+              });
+        }
+      });
+}
+} // namespace rebin_detail
+
 template <class T> class VariableConceptT;
+
+/// Special rebin version for rebinning the inner dimension.
+///
+/// Work is parallel over spectra, and values and variances are rebinned in
+/// the same pass. If old and new coords are 1D the overlaps of old and new
+/// bins are computed only once and shared by all spectra.
 template <class DataType, class OldCoordType, class NewCoordType>
-// Special rebin version for rebinning inner dimension to a joint new coord.
 static void rebinInner(const Dim dim, const VariableConceptT<DataType> &oldT,
                        VariableConceptT<DataType> &newT,
                        const VariableConceptT<OldCoordType> &oldCoordT,
-                       const VariableConceptT<NewCoordType> &newCoordT,
-                       bool variances = false) {
-  scipp::span<const DataType> oldData;
-  scipp::span<DataType> newData;
-  if (variances) {
-    oldData = oldT.variances();
-    newData = newT.variances();
-  } else {
-    oldData = oldT.values();
-    newData = newT.values();
-  }
+                       const VariableConceptT<NewCoordType> &newCoordT) {
+  using namespace rebin_detail;
   const auto oldSize = oldT.dims()[dim];
   const auto newSize = newT.dims()[dim];
   const auto count = oldT.dims().volume() / oldSize;
-  const auto &xold = oldCoordT.values();
-  const auto &xnew = newCoordT.values();
+  const auto xold = oldCoordT.values();
+  const auto xnew = newCoordT.values();
+  const bool variances = oldT.hasVariances();
+  const auto oldValues = oldT.values();
+  const auto newValues = newT.values();
+  const auto oldVariances = variances ? oldT.variances() : oldValues;
+  const auto newVariances = variances ? newT.variances() : newValues;
+  const auto add = [&](const scipp::index c, const scipp::index iold,
+                       const scipp::index inew, const double weight) {
+    const auto o = c * oldSize + iold;
+    const auto n = c * newSize + inew;
+    add_scaled(&newValues[n], &oldValues[o], weight, 1);
+    if (variances)
+      add_scaled(&newVariances[n], &oldVariances[o], weight, 1);
+  };
   // This function assumes that dimensions between coord and data either
   // match, or coord is 1D.
   const bool jointOld = oldCoordT.dims().shape().size() == 1;
   const bool jointNew = newCoordT.dims().shape().size() == 1;
-  for (scipp::index c = 0; c < count; ++c) {
-    scipp::index iold = 0;
-    scipp::index inew = 0;
-    const scipp::index oldEdgeOffset = jointOld ? 0 : c * (oldSize + 1);
-    const scipp::index newEdgeOffset = jointNew ? 0 : c * (newSize + 1);
-    const auto oldOffset = c * oldSize;
-    const auto newOffset = c * newSize;
-    while ((iold < oldSize) && (inew < newSize)) {
-      auto xo_low = xold[oldEdgeOffset + iold];
-      auto xo_high = xold[oldEdgeOffset + iold + 1];
-      auto xn_low = xnew[newEdgeOffset + inew];
-      auto xn_high = xnew[newEdgeOffset + inew + 1];
-
-      if (xn_high <= xo_low)
-        inew++; /* old and new bins do not overlap */
-      else if (xo_high <= xn_low)
-        iold++; /* old and new bins do not overlap */
-      else {
-        // delta is the overlap of the bins on the x axis
-        auto delta = std::min<double>(xn_high, xo_high) -
-                     std::max<double>(xn_low, xo_low);
-
-        auto owidth = xo_high - xo_low;
-        newData[newOffset + inew] += oldData[oldOffset + iold] * delta / owidth;
-
-        if (xn_high > xo_high) {
-          iold++;
-        } else {
-          inew++;
-        }
-      }
-    }
+  if (jointOld && jointNew) {
+    std::vector<std::tuple<scipp::index, scipp::index, double>> overlaps;
+    for_each_overlap(xold.data(), oldSize, xnew.data(), newSize, 1,
+                     [&overlaps](const auto iold, const auto inew,
+                                 const auto weight) {
+                       overlaps.emplace_back(iold, inew, weight);
+                     });
+    parallel::parallel_for(
+        parallel::blocked_range(0, count), [&](const auto &range) {
+          for (auto c = range.begin(); c < range.end(); ++c)
+            for (const auto &[iold, inew, weight] : overlaps)
+              add(c, iold, inew, weight);
+        });
+  } else {
+    parallel::parallel_for(
+        parallel::blocked_range(0, count), [&](const auto &range) {
+          for (auto c = range.begin(); c < range.end(); ++c)
+            for_each_overlap(
+                xold.data() + (jointOld ? 0 : c * (oldSize + 1)), oldSize,
+                xnew.data() + (jointNew ? 0 : c * (newSize + 1)), newSize, 1,
+                [&](const auto iold, const auto inew, const auto weight) {
+                  add(c, iold, inew, weight);
+                });
+        });
   }
 }
 
+/// Rebin a dimension that is not the inner dimension of `var`.
+///
+/// Overlaps of old and new bins are computed once per set of edges and
+/// applied to contiguous rows of the inner dimensions. Bin edges may be
+/// multi-dimensional. Variances are rebinned with the same weights as the
+/// values, as in rebinInner.
 template <typename T>
-void rebin_non_inner(const Dim dim, const VariableConstView &oldT,
-                     Variable &newT, const VariableConstView &oldCoordT,
-                     const VariableConstView &newCoordT) {
-  const auto oldSize = oldT.dims()[dim];
-  const auto newSize = newT.dims()[dim];
-
-  const auto *xold = oldCoordT.values<T>().data();
-  const auto *xnew = newCoordT.values<T>().data();
-  // This function assumes that dimensions between coord and data
-  // coord is 1D.
-  int iold = 0;
-  int inew = 0;
-  while ((iold < oldSize) && (inew < newSize)) {
-    auto xo_low = xold[iold];
-    auto xo_high = xold[iold + 1];
-    auto xn_low = xnew[inew];
-    auto xn_high = xnew[inew + 1];
+void rebin_non_inner(const Dim dim, const VariableConstView &var,
+                     Variable &rebinned, const VariableConstView &oldCoord,
+                     const VariableConstView &newCoord) {
+  using namespace rebin_detail;
+  std::optional<Variable> contiguous;
+  if (!var.data().isContiguous())
+    contiguous = Variable(var);
+  const auto old = contiguous ? VariableConstView(*contiguous) : var;
+  const auto &dims = old.dims();
+  const auto oldSize = dims[dim];
+  const auto newSize = rebinned.dims()[dim];
+  const auto inner = dims.offset(dim);
+  const auto outer = dims.volume() / (oldSize * inner);
 
-    if (xn_high <= xo_low)
-      inew++; /* old and new bins do not overlap */
-    else if (xo_high <= xn_low)
-      iold++; /* old and new bins do not overlap */
-    else {
-      // delta is the overlap of the bins on the x axis
-      auto delta = std::min(xn_high, xo_high) - std::max(xn_low, xo_low);
+  bool depends_on_inner = false;
+  auto edgeDims = dims;
+  const auto labels = dims.labels();
+  for (auto it = std::find(labels.begin(), labels.end(), dim) + 1;
+       it != labels.end(); ++it)
+    if (oldCoord.dims().contains(*it) || newCoord.dims().contains(*it))
+      depends_on_inner = true;
+  if (!depends_on_inner) {
+    for (auto it = std::find(labels.begin(), labels.end(), dim) + 1;
+         it != labels.end(); ++it)
+      edgeDims.erase(*it);
+  }
+  edgeDims.resize(dim, oldSize + 1);
+  const auto xold = get_edges(oldCoord, edgeDims);
+  edgeDims.resize(dim, newSize + 1);
+  const auto xnew = get_edges(newCoord, edgeDims);
 
-      auto owidth = xo_high - xo_low;
-      newT.slice({dim, inew}) +=
-          astype(oldT.slice({dim, iold}) * delta / owidth, newT.dtype());
-      if (xn_high > xo_high) {
-        iold++;
-      } else {
-        inew++;
-      }
+  const auto run = [&](const T *in, T *out) {
+    if (depends_on_inner) {
+      rebin_columns(in, out, outer, oldSize, newSize, inner, xold, xnew);
+    } else {
+      const bool shared = oldCoord.dims().ndim() == 1 &&
+                          newCoord.dims().ndim() == 1;
+      std::vector<Overlap> overlaps;
+      for (scipp::index o = 0; o < (shared ? 1 : outer); ++o)
+        overlaps.emplace_back(xold.data() + o * (oldSize + 1), oldSize,
+                              xnew.data() + o * (newSize + 1), newSize);
+      rebin_rows(in, out, outer, oldSize, newSize, inner, overlaps);
     }
-  }
+  };
+  run(old.values<T>().data(), rebinned.values<T>().data());
+  if (old.hasVariances())
+    run(old.variances<T>().data(), rebinned.variances<T>().data());
 }
 
 Variable rebin(const VariableConstView &var, const Dim dim,
@@ -140,15 +314,14 @@ Variable rebin(const VariableConstView &var, const Dim dim,
     // dimension along which the data is being rebinned
     const bool rebin_dim_valid = out_dims.inner() == dim;
 
-    const bool input_valid = isBinEdge(dim, oldCoordT.dims(), oldT.dims());
+    const bool input_valid = isBinEdge(dim, oldCoordT.dims(), oldT.dims()) &&
+                             is1DOrMatching(dim, oldCoordT.dims(), oldT.dims());
 
-    const bool output_valid =
-        is1D(newCoordT.dims()) && isBinEdge(dim, newCoordT.dims(), out_dims);
+    const bool output_valid = isBinEdge(dim, newCoordT.dims(), out_dims) &&
+                              is1DOrMatching(dim, newCoordT.dims(), out_dims);
 
     if (rebin_dim_valid && input_valid && output_valid) {
       rebinInner(dim, oldT, outT, oldCoordT, newCoordT);
-      if (oldT.hasVariances())
-        rebinInner(dim, oldT, outT, oldCoordT, newCoordT, true);
     } else if (!rebin_dim_valid) {
       // TODO the new coord should be 1D or the same dim as newCoord.
       throw std::runtime_error(
@@ -157,8 +330,9 @@ Variable rebin(const VariableConstView &var, const Dim dim,
       throw std::runtime_error(
           "The input does not have coordinates with bin-edges.");
     } else if (!output_valid) {
-      throw std::runtime_error(
-          "The output is not 1D or does not have coordinates with bin-edges.");
+      throw std::runtime_error("The output coordinate is not 1D or does not "
+                               "match the dimensions of the data, or does "
+                               "not have bin-edges.");
     }
   };
 
@@ -171,16 +345,16 @@ Variable rebin(const VariableConstView &var, const Dim dim,
                    std::tuple<float, float, float, double>, mask_rebinning_t>(
         do_rebin, rebinned, var, oldCoord, newCoord);
   } else {
-    if (newCoord.dims().ndim() > 1)
-      throw std::runtime_error(
-          "Not inner rebin works only for 1d coordinates for now.");
-    switch (oldCoord.dtype()) {
+    switch (var.dtype()) {
     case dtype<double>:
       rebin_non_inner<double>(dim, var, rebinned, oldCoord, newCoord);
       break;
     case dtype<float>:
       rebin_non_inner<float>(dim, var, rebinned, oldCoord, newCoord);
       break;
+    case dtype<bool>:
+      rebin_non_inner<bool>(dim, var, rebinned, oldCoord, newCoord);
+      break;
     default:
       throw std::runtime_error(
           "Rebinning is possible only for double and float types.");
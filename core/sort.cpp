@@ -16,14 +16,19 @@ template <class T> struct MakePermutation {
     if (key.dims().ndim() != 1)
       throw except::DimensionError("Sort key must be 1-dimensional");
 
-    // Variances are ignored for sorting.
-    const auto &values = key.values<T>();
+    // Variances are ignored for sorting. Random access into the element view
+    // is slow, so we collect pointers to the elements first.
+    std::vector<const T *> values;
+    values.reserve(key.dims().volume());
+    for (const auto &value : key.values<T>())
+      values.emplace_back(&value);
 
     std::vector<scipp::index> permutation(values.size());
     std::iota(permutation.begin(), permutation.end(), 0);
-    std::sort(
-        permutation.begin(), permutation.end(),
-        [&](scipp::index i, scipp::index j) { return values[i] < values[j]; });
+    std::sort(permutation.begin(), permutation.end(),
+              [&](scipp::index i, scipp::index j) {
+                return *values[i] < *values[j];
+              });
     return permutation;
   }
 };
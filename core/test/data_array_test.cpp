@@ -214,3 +214,78 @@ TEST(DataArraySparseArithmeticTest, sparse_over_histogram) {
                      expected.slice({Dim::X, 0, 3}).variances<double>()));
   EXPECT_TRUE(std::isnan(out_vars[1][3]));
 }
+
+auto make_sparse_with_data() {
+  auto sparse = make_sparse();
+  Variable data(sparse.coords()[Dim::X]);
+  data.setUnit(units::counts);
+  data *= 0.0;
+  data += 2.0 * units::Unit(units::counts);
+  data.setVariances(Variable(data));
+  sparse.setData(data);
+  return sparse;
+}
+
+TEST(DataArraySparseArithmeticTest,
+     sparse_with_values_times_histogram_in_place) {
+  const auto sparse = make_sparse_with_data();
+  for (const auto &hist : {make_histogram(), make_histogram_no_variance()}) {
+    auto result = copy(sparse);
+    result *= hist;
+    EXPECT_EQ(result, sparse * hist);
+    EXPECT_EQ(result.unit(), units::counts);
+  }
+}
+
+TEST(DataArraySparseArithmeticTest,
+     sparse_with_values_over_histogram_in_place) {
+  auto result = make_sparse_with_data();
+  result /= make_histogram();
+  EXPECT_EQ(result.unit(), units::counts);
+  const auto expected =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{2, 2, 2},
+                           Variances{2, 2, 2}) /
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{2.0, 3.0, 3.0},
+                           Variances{0.3, 0.4, 0.4});
+  EXPECT_TRUE(equals(result.data().sparseValues<double>()[0],
+                     expected.values<double>()));
+  EXPECT_TRUE(equals(result.data().sparseVariances<double>()[0],
+                     expected.variances<double>()));
+}
+
+TEST(DataArraySparseArithmeticTest, sparse_times_histogram_non_linear_edges) {
+  const auto edges = makeVariable<double>(
+      Dims{Dim::X}, Shape{4}, units::Unit(units::us), Values{0, 1, 3, 4});
+  const DataArray hist(
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3},
+                           Variances{1, 2, 3}),
+      {{Dim::X, edges}});
+  // Bins of events are {1, 1, 2} and {1, 1, 2, out of range}.
+  const auto sparse = make_sparse();
+  const auto result = sparse * hist;
+  EXPECT_EQ(result.data().sparseValues<double>()[0],
+            sparse_container<double>({2, 2, 3}));
+  EXPECT_EQ(result.data().sparseValues<double>()[1],
+            sparse_container<double>({2, 2, 3, 0}));
+  EXPECT_EQ(result.data().sparseVariances<double>()[1],
+            sparse_container<double>({6, 6, 12, 0}));
+
+  auto with_data = make_sparse_with_data();
+  const auto expected = with_data * hist;
+  with_data *= hist;
+  EXPECT_EQ(with_data, expected);
+  EXPECT_EQ(with_data.data().sparseValues<double>()[1],
+            sparse_container<double>({4, 4, 6, 0}));
+}
+
+TEST(DataArraySparseArithmeticTest,
+     sparse_times_histogram_unsorted_edges_fail) {
+  auto with_data = make_sparse_with_data();
+  const DataArray hist(
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3}),
+      {{Dim::X, makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 4},
+                                     units::Unit(units::us),
+                                     Values{0, 1, 3, 4, 0, 3, 1, 4})}});
+  EXPECT_THROW(with_data *= hist, except::BinEdgeError);
+  EXPECT_EQ(with_data, make_sparse_with_data());
+}
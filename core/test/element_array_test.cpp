@@ -2,7 +2,12 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <vector>
 
 #include "scipp/core/element_array.h"
@@ -180,3 +185,104 @@ TEST(ElementArrayTest, resize_default_init) {
   x.resize(0, default_init_elements);
   check_empty_element_array(x);
 }
+
+class ElementArrayAllocatorTest
+    : public ::testing::TestWithParam<scipp::core::StorageAllocator> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    AllAllocators, ElementArrayAllocatorTest,
+    ::testing::Values(scipp::core::StorageAllocator::Default,
+                      scipp::core::StorageAllocator::Aligned,
+                      scipp::core::StorageAllocator::Pool,
+                      scipp::core::StorageAllocator::HugePages,
+                      scipp::core::StorageAllocator::FirstTouch));
+
+TEST_P(ElementArrayAllocatorTest, allocate_and_copy) {
+  const scipp::core::ScopedStorageAllocator scope(GetParam());
+  element_array<double> x(1 << 20, 1.5);
+  EXPECT_EQ(x.allocator(), GetParam());
+  EXPECT_EQ(x.data()[0], 1.5);
+  EXPECT_EQ(x.data()[(1 << 20) - 1], 1.5);
+  if (GetParam() != scipp::core::StorageAllocator::Default)
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(x.data()) %
+                  scipp::core::storage_alignment,
+              0);
+  element_array<std::vector<int>> y(3, std::vector<int>{1, 2});
+  EXPECT_EQ(y.data()[2], (std::vector<int>{1, 2}));
+  y.resize(4);
+  EXPECT_TRUE(y.data()[3].empty());
+  element_array<std::vector<int>> z(y);
+  EXPECT_EQ(z.allocator(), GetParam());
+}
+
+TEST_P(ElementArrayAllocatorTest, copy_keeps_allocator) {
+  std::optional<element_array<double>> x;
+  {
+    const scipp::core::ScopedStorageAllocator scope(GetParam());
+    const std::vector<double> values{1.0, 2.0, 3.0};
+    x.emplace(values.begin(), values.end());
+  }
+  element_array<double> copy(*x);
+  EXPECT_EQ(copy.allocator(), GetParam());
+  element_array<double> assigned;
+  assigned = *x;
+  EXPECT_EQ(assigned.allocator(), GetParam());
+  copy.resize(5);
+  EXPECT_EQ(copy.allocator(), GetParam());
+}
+
+TEST(ElementArrayAllocatorTest, scoped_allocator) {
+  using scipp::core::StorageAllocator;
+  const auto initial = scipp::core::default_storage_allocator();
+  {
+    const scipp::core::ScopedStorageAllocator scope(StorageAllocator::Pool);
+    EXPECT_EQ(scipp::core::default_storage_allocator(), StorageAllocator::Pool);
+  }
+  EXPECT_EQ(scipp::core::default_storage_allocator(), initial);
+}
+
+TEST(ElementArrayAllocatorTest, to_storage_allocator) {
+  using scipp::core::StorageAllocator;
+  using scipp::core::to_storage_allocator;
+  EXPECT_EQ(to_storage_allocator("default"), StorageAllocator::Default);
+  EXPECT_EQ(to_storage_allocator("aligned"), StorageAllocator::Aligned);
+  EXPECT_EQ(to_storage_allocator("pool"), StorageAllocator::Pool);
+  EXPECT_EQ(to_storage_allocator("huge_pages"), StorageAllocator::HugePages);
+  EXPECT_EQ(to_storage_allocator("first_touch"),
+            StorageAllocator::FirstTouch);
+  EXPECT_THROW(to_storage_allocator("unknown"), std::invalid_argument);
+}
+
+TEST(ElementArrayAllocatorTest, external) {
+  using scipp::core::StorageAllocator;
+  auto owner = std::make_shared<std::vector<double>>(3, 1.5);
+  std::weak_ptr<std::vector<double>> alive = owner;
+  {
+    element_array<double> x(owner->data(), 3, owner);
+    owner.reset();
+    EXPECT_FALSE(alive.expired());
+    EXPECT_EQ(x.allocator(), StorageAllocator::External);
+    EXPECT_EQ(x.data(), alive.lock()->data());
+    x.data()[1] = 2.5;
+    EXPECT_EQ(alive.lock()->at(1), 2.5);
+
+    element_array<double> copy(x);
+    EXPECT_NE(copy.data(), x.data());
+    EXPECT_EQ(copy.allocator(), scipp::core::default_storage_allocator());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), x.begin(), x.end()));
+
+    element_array<double> moved(std::move(x));
+    EXPECT_FALSE(alive.expired());
+    moved.resize(4);
+    EXPECT_TRUE(alive.expired());
+    EXPECT_EQ(moved.allocator(), scipp::core::default_storage_allocator());
+  }
+  EXPECT_TRUE(alive.expired());
+}
+
+TEST(ElementArrayAllocatorTest, external_cannot_be_default) {
+  using scipp::core::StorageAllocator;
+  const scipp::core::ScopedStorageAllocator scope(StorageAllocator::External);
+  EXPECT_EQ(scipp::core::default_storage_allocator(),
+            StorageAllocator::Default);
+}
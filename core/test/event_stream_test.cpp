@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+#include "test_macros.h"
+#include <gtest/gtest.h>
+
+#include "scipp/core/dataset.h"
+#include "scipp/core/event_stream.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace {
+/// Empty event lists with tof, weights, and pulse times.
+DataArray make_events(const scipp::index nrow) {
+  return DataArray(
+      makeVariable<double>(Dims{Dim::X, Dim::Tof},
+                           Shape{nrow, Dimensions::Sparse},
+                           units::Unit(units::counts), Values{}, Variances{}),
+      {{Dim::Tof, makeVariable<double>(Dims{Dim::X, Dim::Tof},
+                                       Shape{nrow, Dimensions::Sparse},
+                                       units::Unit(units::us))}},
+      {{"pulse_time",
+        makeVariable<int64_t>(Dims{Dim::X, Dim::Tof},
+                              Shape{nrow, Dimensions::Sparse})}});
+}
+
+/// Batch of events with tof given by `tof` and weights and pulse times
+/// derived from it.
+DataArray make_batch(const std::vector<double> &tof, const int64_t pulse) {
+  const auto size = scipp::size(tof);
+  std::vector<double> weights(tof);
+  for (auto &w : weights)
+    w *= 0.5;
+  return DataArray(
+      makeVariable<double>(Dims{Dim::Tof}, Shape{size},
+                           units::Unit(units::counts),
+                           Values(weights.begin(), weights.end()),
+                           Variances(tof.begin(), tof.end())),
+      {{Dim::Tof,
+        makeVariable<double>(Dims{Dim::Tof}, Shape{size},
+                             units::Unit(units::us),
+                             Values(tof.begin(), tof.end()))}},
+      {{"pulse_time",
+        makeVariable<int64_t>(Dims{Dim::Tof}, Shape{size},
+                              Values(std::vector<int64_t>(size, pulse)))}});
+}
+
+Variable make_index(const std::vector<int64_t> &index) {
+  return makeVariable<int64_t>(Dims{Dim::Tof}, Shape{scipp::size(index)},
+                               Values(index.begin(), index.end()));
+}
+} // namespace
+
+TEST(SparseAppendTest, append) {
+  auto events = make_events(3);
+  sparse::append(events, make_index({2, 0, 2}), make_batch({1, 2, 3}, 7));
+  sparse::append(events, make_index({2, 2}), make_batch({4, 5}, 8));
+
+  auto expected = make_events(3);
+  expected.coords()[Dim::Tof].sparseValues<double>()[0] = {2};
+  expected.coords()[Dim::Tof].sparseValues<double>()[2] = {1, 3, 4, 5};
+  expected.labels()["pulse_time"].sparseValues<int64_t>()[0] = {7};
+  expected.labels()["pulse_time"].sparseValues<int64_t>()[2] = {7, 7, 8, 8};
+  expected.data().sparseValues<double>()[0] = {1};
+  expected.data().sparseValues<double>()[2] = {0.5, 1.5, 2, 2.5};
+  expected.data().sparseVariances<double>()[0] = {2};
+  expected.data().sparseVariances<double>()[2] = {1, 3, 4, 5};
+  EXPECT_EQ(events, expected);
+}
+
+TEST(SparseAppendTest, append_many_batches) {
+  auto events = make_events(5);
+  std::vector<double> all;
+  for (int64_t pulse = 0; pulse < 100; ++pulse) {
+    std::vector<int64_t> index;
+    std::vector<double> tof;
+    for (int64_t i = 0; i < 20; ++i) {
+      index.push_back((i * 3 + pulse) % 5);
+      tof.push_back(static_cast<double>(pulse * 20 + i));
+    }
+    sparse::append(events, make_index(index), make_batch(tof, pulse));
+  }
+  scipp::index total = 0;
+  for (scipp::index row = 0; row < 5; ++row) {
+    const auto tof = events.coords()[Dim::Tof].sparseValues<double>()[row];
+    total += scipp::size(tof);
+    EXPECT_TRUE(std::is_sorted(tof.begin(), tof.end()));
+    for (const auto t : tof) {
+      const auto pulse = static_cast<int64_t>(t) / 20;
+      const auto i = static_cast<int64_t>(t) % 20;
+      EXPECT_EQ((i * 3 + pulse) % 5, row);
+    }
+  }
+  EXPECT_EQ(total, 2000);
+}
+
+TEST(SparseAppendTest, append_slice_of_batch) {
+  auto events = make_events(2);
+  const auto batch = make_batch({1, 2, 3, 4}, 1);
+  sparse::append(events, make_index({0, 1}), batch.slice({Dim::Tof, 1, 3}));
+  EXPECT_EQ(events.coords()[Dim::Tof].sparseValues<double>()[0],
+            sparse_container<double>({2}));
+  EXPECT_EQ(events.coords()[Dim::Tof].sparseValues<double>()[1],
+            sparse_container<double>({3}));
+}
+
+TEST(SparseAppendTest, batch_data_ignored_without_weights) {
+  const auto weighted = make_events(2);
+  DataArray events(std::nullopt,
+                   {{Dim::Tof, Variable(weighted.coords()[Dim::Tof])}},
+                   {{"pulse_time", Variable(weighted.labels()["pulse_time"])}});
+  sparse::append(events, make_index({1, 1}), make_batch({1, 2}, 3));
+  EXPECT_FALSE(events.hasData());
+  EXPECT_EQ(events.coords()[Dim::Tof].sparseValues<double>()[1],
+            sparse_container<double>({1, 2}));
+  EXPECT_EQ(events.labels()["pulse_time"].sparseValues<int64_t>()[1],
+            sparse_container<int64_t>({3, 3}));
+}
+
+TEST(SparseAppendTest, bad_batch_fails) {
+  auto events = make_events(3);
+  const auto index = make_index({0, 1});
+  auto batch = make_batch({1, 2}, 0);
+  EXPECT_THROW(sparse::append(events, make_index({0, 3}), batch),
+               except::SizeError);
+  EXPECT_THROW(sparse::append(events, make_index({0}), batch),
+               except::SizeError);
+  const Variable tof(batch.coords()[Dim::Tof]);
+  const DataArray no_labels(Variable(batch.data()), {{Dim::Tof, tof}});
+  EXPECT_THROW(sparse::append(events, index, no_labels),
+               except::NotFoundError);
+  auto wrong_unit = batch;
+  wrong_unit.coords()[Dim::Tof].setUnit(units::m);
+  EXPECT_THROW(sparse::append(events, index, wrong_unit), except::UnitError);
+  EXPECT_EQ(events, make_events(3));
+}
+
+TEST(EventStreamTest, histograms_are_updated) {
+  EventStream stream(make_events(3));
+  const auto edges = makeVariable<double>(Dims{Dim::Tof}, Shape{4},
+                                          units::Unit(units::us),
+                                          Values{0, 2, 4, 6});
+  stream.addHistogram("coarse", edges);
+  stream.append(make_index({2, 0, 2}), make_batch({1, 2, 3}, 7));
+  stream.addHistogram(
+      "fine", makeVariable<double>(Dims{Dim::Tof}, Shape{7},
+                                   units::Unit(units::us),
+                                   Values{0, 1, 2, 3, 4, 5, 6}));
+  stream.append(make_index({2, 1}), make_batch({4, 5}, 8));
+  for (const auto &name : {"coarse", "fine"}) {
+    const auto &hist = stream.histogram(name);
+    const auto expected = histogram(stream.events(), hist.coords()[Dim::Tof]);
+    EXPECT_EQ(hist.data(), expected.data());
+  }
+  ASSERT_THROW_NODISCARD(stream.histogram("missing"), except::NotFoundError);
+}
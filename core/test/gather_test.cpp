@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include "test_macros.h"
+#include <gtest/gtest.h>
+
+#include "scipp/core/dataset.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+TEST(GatherTest, variable_empty) {
+  const auto var = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                        Values{1, 2, 3, 4, 5, 6});
+  EXPECT_EQ(gather(var, Dim::X, {}),
+            makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 0}));
+}
+
+TEST(GatherTest, variable_ranges_and_repeats) {
+  const auto var = makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{2, 4}, units::Unit(units::m),
+      Values{1, 2, 3, 4, 5, 6, 7, 8}, Variances{9, 10, 11, 12, 13, 14, 15, 16});
+  const auto expected = makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{2, 6}, units::Unit(units::m),
+      Values{3, 4, 1, 2, 2, 3, 7, 8, 5, 6, 6, 7},
+      Variances{11, 12, 9, 10, 10, 11, 15, 16, 13, 14, 14, 15});
+  EXPECT_EQ(gather(var, Dim::X, {2, 3, 0, 1, 1, 2}), expected);
+  EXPECT_EQ(gather(var, Dim::Y, {1, 0}),
+            concatenate(var.slice({Dim::Y, 1, 2}), var.slice({Dim::Y, 0, 1}),
+                        Dim::Y));
+}
+
+TEST(GatherTest, variable_sparse) {
+  auto var = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                  Shape{3, Dimensions::Sparse});
+  auto vals = var.sparseValues<double>();
+  vals[0] = {1};
+  vals[1] = {2, 3};
+  vals[2] = {4, 5, 6};
+  const auto gathered = gather(var, Dim::X, {2, 0});
+  EXPECT_EQ(gathered.dims(), (Dimensions{{Dim::X, Dim::Y},
+                                         {2, Dimensions::Sparse}}));
+  EXPECT_EQ(gathered.sparseValues<double>()[0], vals[2]);
+  EXPECT_EQ(gathered.sparseValues<double>()[1], vals[0]);
+}
+
+TEST(GatherTest, data_array) {
+  DataArray a(
+      makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3}),
+      {{Dim::X, makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{4, 5, 6})},
+       {Dim::Y, makeVariable<int>(Values{7})}},
+      {{"labels",
+        makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{8, 9, 10})}},
+      {{"mask", makeVariable<bool>(Dims{Dim::X}, Shape{3},
+                                   Values{true, false, false})}},
+      {{"attr",
+        makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{11, 12, 13})}});
+
+  DataArray expected(
+      makeVariable<int>(Dims{Dim::X}, Shape{2}, Values{3, 1}),
+      {{Dim::X, makeVariable<int>(Dims{Dim::X}, Shape{2}, Values{6, 4})},
+       {Dim::Y, makeVariable<int>(Values{7})}},
+      {{"labels", makeVariable<int>(Dims{Dim::X}, Shape{2}, Values{10, 8})}},
+      {{"mask",
+        makeVariable<bool>(Dims{Dim::X}, Shape{2}, Values{false, true})}},
+      {{"attr", makeVariable<int>(Dims{Dim::X}, Shape{2}, Values{13, 11})}});
+
+  EXPECT_EQ(gather(a, Dim::X, {2, 0}), expected);
+}
+
+TEST(GatherTest, data_array_bin_edges) {
+  DataArray a(
+      makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3}),
+      {{Dim::X,
+        makeVariable<int>(Dims{Dim::X}, Shape{4}, Values{4, 5, 6, 7})}});
+
+  DataArray expected(
+      makeVariable<int>(Dims{Dim::X}, Shape{2}, Values{2, 3}),
+      {{Dim::X, makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{5, 6, 7})}});
+
+  EXPECT_EQ(gather(a, Dim::X, {1, 2}), expected);
+  EXPECT_THROW(gather(a, Dim::X, {2, 1}), except::VariableMismatchError);
+}
+
+TEST(GatherTest, dataset) {
+  Dataset d;
+  d.setCoord(Dim::X,
+             makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3}));
+  d.setData("a",
+            makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{4, 5, 6}));
+  d.setData("scalar", makeVariable<double>(Values{1.2}));
+  d.setAttr("attr",
+            makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{7, 8, 9}));
+
+  Dataset expected;
+  expected.setCoord(Dim::X, makeVariable<int>(Dims{Dim::X}, Shape{4},
+                                              Values{3, 1, 2, 3}));
+  expected.setData("a", makeVariable<int>(Dims{Dim::X}, Shape{4},
+                                          Values{6, 4, 5, 6}));
+  expected.setAttr("attr", makeVariable<int>(Dims{Dim::X}, Shape{4},
+                                             Values{9, 7, 8, 9}));
+
+  EXPECT_EQ(gather(d, Dim::X, {2, 0, 1, 2}), expected);
+}
@@ -2,6 +2,8 @@
 // Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "scipp/core/groupby.h"
 
 #include "test_macros.h"
@@ -266,6 +268,21 @@ TEST(GroupbyMaskedDataArrayTest, mean2) {
   EXPECT_TRUE(std::isnan(result.template values<double>()[3]));
 }
 
+TEST(GroupbyMaskedDataArrayTest, mean_int_with_variances) {
+  DataArray arr{
+      makeVariable<int64_t>(Dimensions{Dim::X, 4}, units::Unit(units::m),
+                            Values{1, 2, 3, 4}, Variances{4, 4, 8, 8}),
+      {},
+      {{"labels", makeVariable<double>(Dimensions{Dim::X, 4},
+                                       Values{1, 1, 2, 2})}},
+      {{"mask", makeVariable<bool>(Dimensions{Dim::X, 4},
+                                   Values{false, false, true, false})}}};
+  const auto result = groupby(arr, "labels", Dim::Y).mean(Dim::X);
+  EXPECT_EQ(result.data(),
+            makeVariable<double>(Dims{Dim::Y}, Shape{2}, units::Unit(units::m),
+                                 Values{1.5, 4.0}, Variances{2.0, 8.0}));
+}
+
 struct GroupbyWithBinsTest : public ::testing::Test {
   GroupbyWithBinsTest() {
     d.setData("a",
@@ -548,3 +565,140 @@ TEST_F(GroupbyMinMaxTest, max) {
                                          units::Unit(units::m), Values{1, 3}));
   EXPECT_EQ(groupby(d, "labels2", Dim::Y).max(Dim::X), expected);
 }
+
+namespace {
+/// Reference implementation of grouping, consecutive rows with equal key form
+/// a single slice.
+template <class T>
+std::vector<GroupByGrouping::group>
+reference_groups(const std::vector<T> &keys) {
+  std::map<T, GroupByGrouping::group> groups;
+  for (scipp::index i = 0; i < scipp::size(keys);) {
+    const auto begin = i;
+    while (i < scipp::size(keys) && keys[i] == keys[begin])
+      ++i;
+    groups[keys[begin]].emplace_back(Dim::X, begin, i);
+  }
+  std::vector<GroupByGrouping::group> out;
+  for (auto &item : groups)
+    out.emplace_back(std::move(item.second));
+  return out;
+}
+} // namespace
+
+// Enough rows for parallel construction of groups, with runs crossing the
+// boundaries of chunks processed by different threads.
+TEST(GroupbyLargeTest, int64) {
+  std::vector<int64_t> keys;
+  for (scipp::index i = 0; i < 100000; ++i)
+    keys.push_back((i / 1000) % 7 - 3);
+  const auto size = scipp::size(keys);
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{size}));
+  a.labels().set("key",
+                 makeVariable<int64_t>(Dims{Dim::X}, Shape{size},
+                                       Values(keys.begin(), keys.end())));
+  const auto grouped = groupby(a, "key", Dim::Y);
+  EXPECT_EQ(grouped.key(),
+            makeVariable<int64_t>(Dims{Dim::Y}, Shape{7},
+                                  Values{-3, -2, -1, 0, 1, 2, 3}));
+  EXPECT_EQ(grouped.groups(), reference_groups(keys));
+}
+
+TEST(GroupbyLargeTest, string) {
+  std::vector<std::string> keys;
+  for (scipp::index i = 0; i < 100000; ++i)
+    keys.push_back(std::to_string((i * 7919) % 101));
+  const auto size = scipp::size(keys);
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{size}));
+  a.labels().set("key",
+                 makeVariable<std::string>(Dims{Dim::X}, Shape{size},
+                                           Values(keys.begin(), keys.end())));
+  const auto grouped = groupby(a, "key", Dim::Y);
+  const auto expected = reference_groups(keys);
+  EXPECT_EQ(grouped.size(), 101);
+  EXPECT_EQ(grouped.groups(), expected);
+  for (scipp::index group = 0; group < grouped.size(); ++group)
+    EXPECT_EQ(grouped.key().values<std::string>()[group],
+              keys[expected[group].front().begin()]);
+}
+
+TEST(GroupbyLargeTest, bins) {
+  std::vector<double> keys;
+  for (scipp::index i = 0; i < 100000; ++i)
+    keys.push_back(static_cast<double>((i / 1000) % 11) - 0.5);
+  const auto size = scipp::size(keys);
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{size}));
+  a.labels().set("key", makeVariable<double>(Dims{Dim::X}, Shape{size},
+                                             Values(keys.begin(), keys.end())));
+  const auto bins =
+      makeVariable<double>(Dims{Dim::Y}, Shape{4}, Values{0.0, 1.0, 4.0, 9.0});
+  const auto grouped = groupby(a, "key", bins);
+  // Reference with keys replaced by bin index, -1 if out of range.
+  std::vector<int64_t> bin(keys.size());
+  std::transform(keys.begin(), keys.end(), bin.begin(), [](const double x) {
+    return x < 0.0 || x >= 9.0 ? -1 : x < 1.0 ? 0 : x < 4.0 ? 1 : 2;
+  });
+  auto expected = reference_groups(bin);
+  expected.erase(expected.begin());
+  EXPECT_EQ(grouped.groups(), expected);
+}
+
+TEST(GroupbyKeyTest, nan_and_signed_zero) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  DataArray a(makeVariable<double>(Dims{Dim::X}, Shape{6},
+                                   Values{1, 2, 3, 4, 5, 6}));
+  a.labels().set("key", makeVariable<double>(Dims{Dim::X}, Shape{6},
+                                             Values{nan, 0.0, 1.0, -0.0, nan,
+                                                    1.0}));
+  const auto grouped = groupby(a, "key", Dim::Y);
+  ASSERT_EQ(scipp::size(grouped), 3);
+  EXPECT_EQ(grouped.key().values<double>()[0], 0.0);
+  EXPECT_EQ(grouped.key().values<double>()[1], 1.0);
+  EXPECT_TRUE(std::isnan(grouped.key().values<double>()[2]));
+  EXPECT_EQ(grouped.sum(Dim::X).data(),
+            makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{6, 9, 6}));
+}
+
+// Few groups with very different cost, such that the reduction of large groups
+// is split into parts along the other dimension.
+TEST(GroupbyLargeTest, sum_skewed_2d) {
+  const scipp::index nx = 1000;
+  const scipp::index ny = 100;
+  const scipp::index ngroup = 4;
+  std::vector<double> values(nx * ny);
+  std::iota(values.begin(), values.end(), 0.0);
+  std::vector<int64_t> keys(nx);
+  std::vector<bool> mask(nx);
+  for (scipp::index x = 0; x < nx; ++x) {
+    keys[x] = x < 990 ? 0 : x % 3 + 1;
+    mask[x] = x % 7 == 0;
+  }
+  Dataset d;
+  d.setData("2d", makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{ny, nx},
+                                       Values(values.begin(), values.end())));
+  d.setData("1d", makeVariable<double>(Dims{Dim::X}, Shape{nx},
+                                       Values(values.begin(),
+                                              values.begin() + nx)));
+  d.setLabels("key", makeVariable<int64_t>(Dims{Dim::X}, Shape{nx},
+                                           Values(keys.begin(), keys.end())));
+  d.setMask("mask", makeVariable<bool>(Dims{Dim::X}, Shape{nx},
+                                       Values(mask.begin(), mask.end())));
+
+  std::vector<double> sum2d(ngroup * ny);
+  std::vector<double> sum1d(ngroup);
+  for (scipp::index x = 0; x < nx; ++x) {
+    if (mask[x])
+      continue;
+    for (scipp::index y = 0; y < ny; ++y)
+      sum2d[y * ngroup + keys[x]] += values[y * nx + x];
+    sum1d[keys[x]] += values[x];
+  }
+  const auto grouped = groupby(d, "key", Dim::Z).sum(Dim::X);
+  EXPECT_EQ(grouped["2d"].data(),
+            makeVariable<double>(Dims{Dim::Y, Dim::Z}, Shape{ny, ngroup},
+                                 Values(sum2d.begin(), sum2d.end())));
+  EXPECT_EQ(grouped["1d"].data(),
+            makeVariable<double>(Dims{Dim::Z}, Shape{ngroup},
+                                 Values(sum1d.begin(), sum1d.end())));
+  EXPECT_EQ(groupby(d["2d"], "key", Dim::Z).sum(Dim::X), grouped["2d"]);
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+#include "test_macros.h"
+#include <gtest/gtest.h>
+
+#include "scipp/core/dataset.h"
+#include "scipp/core/histogram_accumulator.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace {
+/// Sparse data with 3 event lists, with weights if `weighted` is true.
+DataArray make_events(const bool weighted) {
+  auto coord =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{3, Dimensions::Sparse});
+  coord.sparseValues<double>()[0] = {1.5, 2.5, 3.5, 4.5, 5.5};
+  coord.sparseValues<double>()[1] = {3.5, 4.5, 5.5, 6.5, 7.5};
+  coord.sparseValues<double>()[2] = {-1, 0, 0, 1, 1, 2, 2, 2, 4, 4, 4, 6};
+  if (!weighted)
+    return DataArray(std::nullopt, {{Dim::Y, coord}});
+  auto weights = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                      Shape{3, Dimensions::Sparse},
+                                      units::Unit(units::counts), Values{},
+                                      Variances{});
+  for (scipp::index i = 0; i < 3; ++i) {
+    const auto size = scipp::size(coord.sparseValues<double>()[i]);
+    for (scipp::index j = 0; j < size; ++j) {
+      weights.sparseValues<double>()[i].push_back(0.5 * (i + j));
+      weights.sparseVariances<double>()[i].push_back(0.25 * j);
+    }
+  }
+  return DataArray(weights, {{Dim::Y, coord}});
+}
+
+/// Return events [begin, end) of every event list of `events`.
+DataArray take(const DataArrayConstView &events, const scipp::index begin,
+               const scipp::index end) {
+  DataArray out(events);
+  const auto n = events.dims()[Dim::X];
+  for (scipp::index i = 0; i < n; ++i) {
+    auto &coord = out.coords()[Dim::Y].sparseValues<double>()[i];
+    const auto stop = std::min(end, scipp::size(coord));
+    const auto start = std::min(begin, stop);
+    const auto keep = [start, stop](auto &c) {
+      c.erase(c.begin() + stop, c.end());
+      c.erase(c.begin(), c.begin() + start);
+    };
+    keep(coord);
+    if (out.hasData()) {
+      keep(out.data().sparseValues<double>()[i]);
+      keep(out.data().sparseVariances<double>()[i]);
+    }
+  }
+  return out;
+}
+
+const auto edges =
+    makeVariable<double>(Dims{Dim::Y}, Shape{6}, Values{1, 2, 3, 4, 5, 6});
+} // namespace
+
+TEST(HistogramAccumulatorTest, empty) {
+  HistogramAccumulator accumulator(Dimensions{Dim::X, 3}, edges);
+  EXPECT_EQ(accumulator.result(),
+            DataArray(makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{3, 5},
+                                           units::Unit(units::counts),
+                                           Values{}, Variances{}),
+                      {{Dim::Y, edges}}));
+}
+
+TEST(HistogramAccumulatorTest, batches_match_histogram) {
+  for (const bool weighted : {false, true}) {
+    const auto events = make_events(weighted);
+    const auto expected = histogram(events, edges);
+    HistogramAccumulator accumulator(Dimensions{Dim::X, 3}, edges);
+    accumulator.add(take(events, 0, 4));
+    accumulator.add(take(events, 4, 5));
+    accumulator.add(take(events, 5, 100));
+    EXPECT_EQ(accumulator.result().data(), expected.data());
+    EXPECT_EQ(accumulator.result().coords(), expected.coords());
+  }
+}
+
+TEST(HistogramAccumulatorTest, slices_match_histogram) {
+  for (const bool weighted : {false, true}) {
+    const auto events = make_events(weighted);
+    const auto expected = histogram(events, edges);
+    HistogramAccumulator accumulator(Dimensions{Dim::X, 3}, edges);
+    accumulator.add(events.slice({Dim::X, 2, 3}), Slice{Dim::X, 2, 3});
+    accumulator.add(events.slice({Dim::X, 0, 2}), Slice{Dim::X, 0, 2});
+    EXPECT_EQ(accumulator.result().data(), expected.data());
+  }
+}
+
+TEST(HistogramAccumulatorTest, flat_events_match_histogram) {
+  const auto events = make_events(true);
+  const auto expected = histogram(events, edges);
+  std::vector<int32_t> index;
+  std::vector<double> coord;
+  std::vector<double> values;
+  std::vector<double> variances;
+  // Interleave events of different event lists.
+  for (scipp::index j = 0; j < 12; ++j)
+    for (scipp::index i = 0; i < 3; ++i) {
+      const auto c = events.coords()[Dim::Y].sparseValues<double>()[i];
+      if (j >= scipp::size(c))
+        continue;
+      index.push_back(i);
+      coord.push_back(c[j]);
+      values.push_back(events.data().sparseValues<double>()[i][j]);
+      variances.push_back(events.data().sparseVariances<double>()[i][j]);
+    }
+  const auto size = scipp::size(index);
+  HistogramAccumulator accumulator(Dimensions{Dim::X, 3}, edges);
+  accumulator.add(
+      makeVariable<int32_t>(Dims{Dim::Row}, Shape{size},
+                            Values(index.begin(), index.end())),
+      makeVariable<double>(Dims{Dim::Row}, Shape{size},
+                           Values(coord.begin(), coord.end())),
+      makeVariable<double>(Dims{Dim::Row}, Shape{size},
+                           units::Unit(units::counts),
+                           Values(values.begin(), values.end()),
+                           Variances(variances.begin(), variances.end())));
+  EXPECT_EQ(accumulator.result().data(), expected.data());
+}
+
+TEST(HistogramAccumulatorTest, flat_events_without_weights) {
+  HistogramAccumulator accumulator(Dimensions{Dim::X, 2}, edges);
+  accumulator.add(
+      makeVariable<int64_t>(Dims{Dim::Row}, Shape{4}, Values{1, 0, 1, 1}),
+      makeVariable<float>(Dims{Dim::Row}, Shape{4},
+                          Values{1.5, 2.5, 5.5, 6.5}));
+  EXPECT_EQ(accumulator.result().data(),
+            makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 5},
+                                 units::Unit(units::counts),
+                                 Values{0, 1, 0, 0, 0, 1, 0, 0, 0, 1},
+                                 Variances{0, 1, 0, 0, 0, 1, 0, 0, 0, 1}));
+}
+
+TEST(HistogramAccumulatorTest, bad_edges_fail) {
+  EXPECT_THROW(HistogramAccumulator(Dimensions{Dim::X, 3},
+                                    makeVariable<double>(Dims{Dim::Y}, Shape{3},
+                                                         Values{1, 3, 2})),
+               except::BinEdgeError);
+  EXPECT_THROW(HistogramAccumulator(Dimensions{Dim::X, 3},
+                                    makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                                         Shape{3, 2})),
+               except::DimensionError);
+  EXPECT_THROW(HistogramAccumulator(Dimensions{Dim::Y, 3}, edges),
+               except::DimensionError);
+}
+
+TEST(HistogramAccumulatorTest, bad_events_fail) {
+  HistogramAccumulator accumulator(Dimensions{Dim::X, 2}, edges);
+  const auto events = make_events(false);
+  EXPECT_THROW(accumulator.add(events), except::DimensionError);
+  EXPECT_THROW(accumulator.add(events.slice({Dim::X, 0, 2}),
+                               Slice{Dim::Y, 0, 2}),
+               except::SliceError);
+  const auto index =
+      makeVariable<int64_t>(Dims{Dim::Row}, Shape{2}, Values{0, 2});
+  const auto coord =
+      makeVariable<double>(Dims{Dim::Row}, Shape{2}, Values{1.5, 2.5});
+  EXPECT_THROW(accumulator.add(index, coord), except::SizeError);
+  EXPECT_THROW(accumulator.add(index.slice({Dim::Row, 0, 1}), coord),
+               except::SizeError);
+  EXPECT_THROW(accumulator.add(index, coord, coord), except::VariancesError);
+  EXPECT_EQ(accumulator.result(),
+            HistogramAccumulator(Dimensions{Dim::X, 2}, edges).result());
+}
+
+TEST(HistogramAccumulatorTest, unit_mismatch_fails) {
+  HistogramAccumulator accumulator(Dimensions{Dim::X, 3}, edges);
+  auto events = make_events(true);
+  EXPECT_NO_THROW(accumulator.add(events));
+  events.setUnit(units::dimensionless);
+  EXPECT_THROW(accumulator.add(events), except::UnitError);
+  events.coords()[Dim::Y].setUnit(units::m);
+  EXPECT_THROW(accumulator.add(events), except::UnitError);
+}
@@ -191,3 +191,179 @@ TEST(HistogramTest, dataset_own_coord) {
   sparse.setCoord(Dim::Y, coord);
   EXPECT_EQ(core::histogram(sparse, Dim::Y), expected);
 }
+
+template <class T> class HistogramLinearTest : public ::testing::Test {};
+using HistogramLinearTypes = ::testing::Types<double, float>;
+TYPED_TEST_SUITE(HistogramLinearTest, HistogramLinearTypes);
+
+// Many events per bin, such that the vectorized code path with sub-histograms
+// is used, with events at bin centers and out of range on both sides.
+TYPED_TEST(HistogramLinearTest, many_events) {
+  using T = TypeParam;
+  const scipp::index nevent = 1000;
+  auto coord = makeVariable<T>(Dims{Dim::X, Dim::Y},
+                               Shape{2, Dimensions::Sparse});
+  auto weights = makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                      Shape{2, Dimensions::Sparse},
+                                      units::Unit(units::counts), Values{},
+                                      Variances{});
+  for (scipp::index i = 0; i < 2; ++i) {
+    auto &c = coord.template sparseValues<T>()[i];
+    for (scipp::index j = 0; j < nevent * (i + 1); ++j)
+      c.push_back(static_cast<T>(j % 12) - static_cast<T>(0.5));
+    weights.sparseValues<double>()[i].assign(scipp::size(c), 2.0);
+    weights.sparseVariances<double>()[i].assign(scipp::size(c), 3.0);
+  }
+  const auto edges = makeVariable<T>(Dims{Dim::Y}, Shape{11},
+                                     Values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  // Bin b contains events with j % 12 == b + 1.
+  std::vector<double> counts;
+  for (scipp::index i = 0; i < 2; ++i)
+    for (scipp::index b = 0; b < 10; ++b) {
+      scipp::index n = 0;
+      for (scipp::index j = 0; j < nevent * (i + 1); ++j)
+        n += j % 12 == b + 1;
+      counts.push_back(n);
+    }
+  std::vector<double> weighted(counts.size());
+  std::vector<double> weighted_var(counts.size());
+  std::transform(counts.begin(), counts.end(), weighted.begin(),
+                 [](const double c) { return 2.0 * c; });
+  std::transform(counts.begin(), counts.end(), weighted_var.begin(),
+                 [](const double c) { return 3.0 * c; });
+
+  const auto hist =
+      histogram(DataArray(std::nullopt, {{Dim::Y, coord}}), edges);
+  EXPECT_EQ(hist.data(),
+            makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 10},
+                                 units::Unit(units::counts),
+                                 Values(counts.begin(), counts.end()),
+                                 Variances(counts.begin(), counts.end())));
+
+  const auto hist_weighted =
+      histogram(DataArray(weights, {{Dim::Y, coord}}), edges);
+  EXPECT_EQ(hist_weighted.data(),
+            makeVariable<double>(
+                Dims{Dim::X, Dim::Y}, Shape{2, 10}, units::Unit(units::counts),
+                Values(weighted.begin(), weighted.end()),
+                Variances(weighted_var.begin(), weighted_var.end())));
+}
+
+// Single event list large enough to be split into chunks which are
+// histogrammed in parallel.
+TEST(HistogramTest, large_event_list) {
+  const scipp::index nevent = 3 << 18;
+  auto coord =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{1, Dimensions::Sparse});
+  auto weights = makeVariable<double>(
+      Dims{Dim::X, Dim::Y}, Shape{1, Dimensions::Sparse},
+      units::Unit(units::counts), Values{}, Variances{});
+  auto &c = coord.sparseValues<double>()[0];
+  for (scipp::index j = 0; j < nevent; ++j)
+    c.push_back(static_cast<double>(j % 12) - 0.5);
+  weights.sparseValues<double>()[0].assign(scipp::size(c), 2.0);
+  weights.sparseVariances<double>()[0].assign(scipp::size(c), 3.0);
+
+  for (const auto &edges :
+       {makeVariable<double>(Dims{Dim::Y}, Shape{6}, Values{0, 2, 4, 6, 8, 10}),
+        makeVariable<double>(Dims{Dim::Y}, Shape{5}, Values{0, 1, 3, 6, 10})}) {
+    const auto e = edges.values<double>();
+    std::vector<double> counts;
+    for (scipp::index b = 0; b < edges.dims().volume() - 1; ++b) {
+      double n = 0;
+      for (scipp::index j = 0; j < 12; ++j) {
+        const double x = static_cast<double>(j) - 0.5;
+        n += (x >= e[b] && x < e[b + 1]) * (nevent / 12);
+      }
+      counts.push_back(n);
+    }
+    std::vector<double> weighted(counts.size());
+    std::vector<double> weighted_var(counts.size());
+    std::transform(counts.begin(), counts.end(), weighted.begin(),
+                   [](const double n) { return 2.0 * n; });
+    std::transform(counts.begin(), counts.end(), weighted_var.begin(),
+                   [](const double n) { return 3.0 * n; });
+    const Dimensions dims{{Dim::X, 1}, {Dim::Y, scipp::size(counts)}};
+
+    EXPECT_EQ(histogram(DataArray(std::nullopt, {{Dim::Y, coord}}), edges)
+                  .data(),
+              makeVariable<double>(Dimensions(dims), units::Unit(units::counts),
+                                   Values(counts.begin(), counts.end()),
+                                   Variances(counts.begin(), counts.end())));
+    EXPECT_EQ(histogram(DataArray(weights, {{Dim::Y, coord}}), edges).data(),
+              makeVariable<double>(
+                  Dimensions(dims), units::Unit(units::counts),
+                  Values(weighted.begin(), weighted.end()),
+                  Variances(weighted_var.begin(), weighted_var.end())));
+  }
+}
+
+namespace {
+template <class Edges>
+std::vector<double> histogram_reference(const std::vector<double> &events,
+                                        const Edges &edges) {
+  std::vector<double> counts(scipp::size(edges) - 1);
+  for (const auto x : events) {
+    auto it = std::upper_bound(edges.begin(), edges.end(), x);
+    if (it != edges.end() && it != edges.begin())
+      ++counts[--it - edges.begin()];
+  }
+  return counts;
+}
+} // namespace
+
+// Events with many different values, including edges and values out of range,
+// for edges with non-constant bin width.
+TEST(HistogramTest, non_linear_edges) {
+  std::vector<double> events;
+  for (scipp::index j = 0; j < 10000; ++j)
+    events.push_back(std::fmod(j * 0.6180339887, 1.0) * 1200.0 - 100.0);
+  std::vector<double> log_edges;
+  for (scipp::index i = 0; i <= 50; ++i)
+    log_edges.push_back(std::pow(1000.0, i / 50.0));
+  std::vector<double> irregular_edges;
+  for (scipp::index i = 0; i <= 50; ++i)
+    irregular_edges.push_back(static_cast<double>(i * i));
+  irregular_edges.insert(irregular_edges.begin() + 10, irregular_edges[10]);
+  events.insert(events.end(), log_edges.begin(), log_edges.end());
+  events.insert(events.end(), irregular_edges.begin(), irregular_edges.end());
+
+  auto coord =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, Dimensions::Sparse});
+  for (scipp::index i = 0; i < 2; ++i)
+    coord.sparseValues<double>()[i].assign(events.begin(), events.end());
+  const DataArray sparse(std::nullopt, {{Dim::Y, coord}});
+
+  for (const auto &e : {log_edges, irregular_edges}) {
+    const auto nbin = scipp::size(e) - 1;
+    const auto edges = makeVariable<double>(Dims{Dim::Y}, Shape{nbin + 1},
+                                            Values(e.begin(), e.end()));
+    auto counts = histogram_reference(events, edges.values<double>());
+    counts.resize(2 * nbin);
+    std::copy_n(counts.begin(), nbin, counts.begin() + nbin);
+    EXPECT_EQ(histogram(sparse, edges).data(),
+              makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, nbin},
+                                   units::Unit(units::counts),
+                                   Values(counts.begin(), counts.end()),
+                                   Variances(counts.begin(), counts.end())));
+  }
+
+  // Different edges for every event list.
+  std::vector<double> edges_2d(log_edges);
+  edges_2d.insert(edges_2d.end(), irregular_edges.begin(),
+                  irregular_edges.begin() + log_edges.size());
+  const auto edges = makeVariable<double>(
+      Dims{Dim::X, Dim::Y}, Shape{2, scipp::size(log_edges)},
+      Values(edges_2d.begin(), edges_2d.end()));
+  auto counts = histogram_reference(
+      events, edges.slice({Dim::X, 0}).values<double>());
+  const auto counts1 = histogram_reference(
+      events, edges.slice({Dim::X, 1}).values<double>());
+  counts.insert(counts.end(), counts1.begin(), counts1.end());
+  EXPECT_EQ(histogram(sparse, edges).data(),
+            makeVariable<double>(Dims{Dim::X, Dim::Y},
+                                 Shape{2, scipp::size(log_edges) - 1},
+                                 units::Unit(units::counts),
+                                 Values(counts.begin(), counts.end()),
+                                 Variances(counts.begin(), counts.end())));
+}
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "scipp/core/io.h"
+
+#include "dataset_test_common.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class IoTest : public ::testing::Test {
+protected:
+  ~IoTest() override { std::remove(filename.c_str()); }
+
+  template <class T> T roundtrip(const T &object) {
+    io::save(object, filename);
+    return io::load<T>(filename);
+  }
+
+  const std::string filename =
+      std::string(
+          ::testing::UnitTest::GetInstance()->current_test_info()->name()) +
+      ".scipp";
+};
+
+TEST_F(IoTest, variable) {
+  const auto var = makeVariable<double>(
+      Dims{Dim::X, Dim::Y}, Shape{2, 3}, units::Unit(units::m),
+      Values{1, 2, 3, 4, 5, 6}, Variances{6, 5, 4, 3, 2, 1});
+  EXPECT_EQ(roundtrip(var), var);
+}
+
+TEST_F(IoTest, variable_dtypes) {
+  for (const auto &var :
+       {makeVariable<float>(Dims{Dim::X}, Shape{2}, Values{1, 2}),
+        makeVariable<int64_t>(Dims{Dim::X}, Shape{2}, Values{1, 2}),
+        makeVariable<int32_t>(Dims{Dim::X}, Shape{2}, Values{1, 2}),
+        makeVariable<bool>(Dims{Dim::X}, Shape{2}, Values{true, false}),
+        makeVariable<std::string>(Dims{Dim::X}, Shape{2},
+                                  Values{"a", "longer string"}),
+        makeVariable<Eigen::Vector3d>(
+            Dims{Dim::X}, Shape{2},
+            Values{Eigen::Vector3d{1, 2, 3}, Eigen::Vector3d{4, 5, 6}}),
+        makeVariable<double>(Values{1.5})})
+    EXPECT_EQ(roundtrip(var), var);
+}
+
+TEST_F(IoTest, variable_slice) {
+  const auto var = makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 3},
+                                        Values{1, 2, 3, 4, 5, 6});
+  for (const auto &slice :
+       {var.slice({Dim::X, 1}), var.slice({Dim::Y, 1, 3}),
+        var.slice({Dim::Y, 2})}) {
+    io::save(slice, filename);
+    EXPECT_EQ(io::load<Variable>(filename), slice);
+  }
+}
+
+TEST_F(IoTest, variable_nested) {
+  DatasetFactory3D factory;
+  const auto dataset = factory.make();
+  const auto var = makeVariable<Dataset>(Dims{Dim::X}, Shape{2},
+                                         Values{dataset, Dataset{}});
+  EXPECT_EQ(roundtrip(var), var);
+  const auto array =
+      makeVariable<DataArray>(Values{DataArray(dataset["data_xyz"])});
+  EXPECT_EQ(roundtrip(array), array);
+}
+
+TEST_F(IoTest, sparse_variable) {
+  auto var = makeVariable<double>(Dims{Dim::Y, Dim::X},
+                                  Shape{2, Dimensions::Sparse},
+                                  units::Unit(units::us), Values{}, Variances{});
+  var.sparseValues<double>()[0] = {1, 2, 3};
+  var.sparseVariances<double>()[0] = {4, 5, 6};
+  EXPECT_EQ(roundtrip(var), var);
+}
+
+TEST_F(IoTest, packed_events) {
+  auto var = makeVariable<float>(Dims{Dim::Y, Dim::X},
+                                 Shape{3, Dimensions::Sparse});
+  var.sparseValues<float>()[0] = {1, 2, 3};
+  var.sparseValues<float>()[2] = {4, 5};
+  const auto packed = sparse::pack(var);
+  EXPECT_EQ(roundtrip(packed), packed);
+
+  // Only the events of the slice are stored.
+  const auto slice = packed.slice({Dim::Y, 2, 3});
+  const auto loaded = roundtrip(slice);
+  EXPECT_EQ(loaded, slice);
+  EXPECT_EQ(loaded.buffer().dims().volume(), 2);
+}
+
+TEST_F(IoTest, data_array) {
+  DatasetFactory3D factory;
+  auto dataset = factory.make();
+  dataset.setAttr("data_xy", "item_attr",
+                  makeVariable<std::string>(Values{"attr"}));
+  for (const auto &item : dataset)
+    EXPECT_EQ(roundtrip(DataArray(item)), item);
+  io::save(dataset["data_xy"].slice({Dim::X, 1, 3}), filename);
+  EXPECT_EQ(io::load<DataArray>(filename),
+            dataset["data_xy"].slice({Dim::X, 1, 3}));
+}
+
+TEST_F(IoTest, dataset) {
+  DatasetFactory3D factory;
+  auto dataset = factory.make();
+  dataset.setAttr("data_xy", "item_attr", makeVariable<double>(Values{1.0}));
+  EXPECT_EQ(roundtrip(dataset), dataset);
+  io::save(dataset.slice({Dim::Y, 2}), filename);
+  EXPECT_EQ(io::load<Dataset>(filename), dataset.slice({Dim::Y, 2}));
+}
+
+TEST_F(IoTest, sparse_dataset) {
+  auto dataset = make_sparse_with_coords_and_labels({1, 2, 3}, {4, 5, 6});
+  dataset.setAttr("sparse", "item_attr", makeVariable<double>(Values{1.0}));
+  EXPECT_EQ(roundtrip(dataset), dataset);
+  const auto array = DataArray(dataset["sparse"]);
+  EXPECT_EQ(roundtrip(array), array);
+}
+
+TEST_F(IoTest, loaded_data_is_private) {
+  const auto var = makeVariable<double>(Dims{Dim::X}, Shape{3},
+                                        Values{1, 2, 3}, Variances{4, 5, 6});
+  io::save(var, filename);
+  auto loaded = io::load<Variable>(filename);
+  loaded.values<double>()[0] = 0.0;
+  loaded += loaded;
+  EXPECT_EQ(io::load<Variable>(filename), var);
+  // Copies do not share the mapped memory.
+  const Variable copy(loaded);
+  loaded.values<double>()[1] = 0.0;
+  EXPECT_NE(copy, loaded);
+}
+
+TEST_F(IoTest, overwrite_loaded_file) {
+  const auto var = makeVariable<double>(Dims{Dim::X}, Shape{3},
+                                        Values{1, 2, 3});
+  io::save(var, filename);
+  const auto loaded = io::load<Variable>(filename);
+  io::save(makeVariable<double>(Dims{Dim::Y}, Shape{1}, Values{4}), filename);
+  EXPECT_EQ(loaded, var);
+  EXPECT_EQ(io::load<Variable>(filename),
+            makeVariable<double>(Dims{Dim::Y}, Shape{1}, Values{4}));
+}
+
+TEST_F(IoTest, load_wrong_type_fails) {
+  io::save(makeVariable<double>(Values{1.0}), filename);
+  ASSERT_NO_THROW_NODISCARD(io::load(filename));
+  ASSERT_THROW_NODISCARD(io::load<Dataset>(filename), except::TypeError);
+}
+
+TEST_F(IoTest, load_bad_file_fails) {
+  ASSERT_THROW_NODISCARD(io::load(filename), except::FileError);
+  std::ofstream(filename) << "not a scipp file";
+  ASSERT_THROW_NODISCARD(io::load(filename), except::FileError);
+}
+
+TEST_F(IoTest, load_truncated_file_fails) {
+  io::save(makeVariable<double>(Dims{Dim::X}, Shape{100}), filename);
+  std::ifstream in(filename, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream(filename, std::ios::binary)
+      << content.substr(0, content.size() / 2);
+  ASSERT_THROW_NODISCARD(io::load(filename), except::FileError);
+}
+
+TEST_F(IoTest, save_unsupported_dtype_fails) {
+  const auto var = makeVariable<std::string>(Dims{Dim::X, Dim::Y},
+                                             Shape{1, Dimensions::Sparse});
+  EXPECT_THROW(io::save(var, filename), std::runtime_error);
+  std::ifstream tmp(filename + ".tmp");
+  EXPECT_FALSE(tmp.good());
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2019 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "scipp/core/memory_pool.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+TEST(MemoryPoolTest, allocation_size) {
+  EXPECT_EQ(MemoryPool::allocation_size(0), 64);
+  EXPECT_EQ(MemoryPool::allocation_size(1), 64);
+  EXPECT_EQ(MemoryPool::allocation_size(64), 64);
+  EXPECT_EQ(MemoryPool::allocation_size(65), 128);
+  EXPECT_EQ(MemoryPool::allocation_size(1000000), 1048576);
+}
+
+TEST(MemoryPoolTest, alignment) {
+  MemoryPool pool;
+  for (const size_t size : {1, 7, 64, 100, 4096, 100000}) {
+    void *ptr = pool.allocate(size);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+    std::memset(ptr, 0xff, size);
+    pool.deallocate(ptr);
+  }
+}
+
+TEST(MemoryPoolTest, reuse) {
+  MemoryPool pool;
+  void *a = pool.allocate(100);
+  pool.deallocate(a);
+  void *b = pool.allocate(120);
+  EXPECT_EQ(a, b);
+  void *c = pool.allocate(1000);
+  EXPECT_NE(b, c);
+  pool.deallocate(b);
+  pool.deallocate(c);
+}
+
+TEST(MemoryPoolTest, deallocate_nullptr) {
+  MemoryPool pool;
+  EXPECT_NO_THROW(pool.deallocate(nullptr));
+  EXPECT_EQ(pool.statistics().bytes_live, 0);
+}
+
+TEST(MemoryPoolTest, statistics) {
+  MemoryPool pool;
+  EXPECT_EQ(pool.statistics().allocations, 0);
+  EXPECT_EQ(pool.statistics().hit_rate(), 0.0);
+  void *a = pool.allocate(100);
+  void *b = pool.allocate(1000);
+  auto stats = pool.statistics();
+  EXPECT_EQ(stats.bytes_live, 128 + 1024);
+  EXPECT_EQ(stats.bytes_peak, 128 + 1024);
+  EXPECT_EQ(stats.allocations, 2);
+  EXPECT_EQ(stats.hits, 0);
+  pool.deallocate(b);
+  b = pool.allocate(1000);
+  pool.deallocate(a);
+  stats = pool.statistics();
+  EXPECT_EQ(stats.bytes_live, 1024);
+  EXPECT_EQ(stats.bytes_peak, 128 + 1024);
+  EXPECT_EQ(stats.allocations, 3);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_DOUBLE_EQ(stats.hit_rate(), 1.0 / 3.0);
+  pool.deallocate(b);
+  EXPECT_EQ(pool.statistics().bytes_live, 0);
+}
+
+TEST(MemoryPoolTest, slot_overflow) {
+  MemoryPool pool;
+  const size_t size = MemoryPool::slot_capacity / 4;
+  std::vector<void *> ptrs;
+  for (int i = 0; i < 16; ++i)
+    ptrs.push_back(pool.allocate(size));
+  for (auto *ptr : ptrs)
+    pool.deallocate(ptr);
+  // Blocks moved to central list are still reused.
+  for (auto &ptr : ptrs)
+    ptr = pool.allocate(size);
+  EXPECT_EQ(pool.statistics().hits, 16);
+  for (auto *ptr : ptrs)
+    pool.deallocate(ptr);
+}
+
+TEST(MemoryPoolTest, threads) {
+  MemoryPool pool;
+  std::vector<std::vector<void *>> ptrs(4);
+  std::vector<std::thread> threads;
+  for (auto &p : ptrs)
+    threads.emplace_back([&pool, &p]() {
+      for (size_t i = 0; i < 1000; ++i) {
+        p.push_back(pool.allocate(8 * (i % 100 + 1)));
+        std::memset(p.back(), 0, 8 * (i % 100 + 1));
+        if (i % 3 == 0) {
+          pool.deallocate(p.back());
+          p.pop_back();
+        }
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+  threads.clear();
+  // Free memory on different threads than it was allocated on.
+  for (size_t i = 0; i < ptrs.size(); ++i)
+    threads.emplace_back([&pool, &p = ptrs[(i + 1) % ptrs.size()]]() {
+      for (auto *ptr : p)
+        pool.deallocate(ptr);
+    });
+  for (auto &thread : threads)
+    thread.join();
+  const auto stats = pool.statistics();
+  EXPECT_EQ(stats.bytes_live, 0);
+  EXPECT_EQ(stats.allocations, 4000);
+}
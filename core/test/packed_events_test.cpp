@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include "scipp/core/dataset.h"
+#include "scipp/core/packed_events.h"
+
+#include "test_macros.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class PackedEventsTest : public ::testing::Test {
+protected:
+  PackedEventsTest() {
+    auto vals = var.sparseValues<double>();
+    auto vars = var.sparseVariances<double>();
+    vals[0] = {1, 2, 3};
+    vals[1] = {};
+    vals[2] = {4, 5};
+    vals[3] = {6};
+    vals[4] = {7, 8, 9, 10};
+    vals[5] = {11, 12};
+    vars[0] = {1, 1, 1};
+    vars[2] = {2, 2};
+    vars[3] = {3};
+    vars[4] = {4, 4, 4, 4};
+    vars[5] = {5, 5};
+  }
+
+  Variable var = makeVariable<double>(Dims{Dim::Y, Dim::X, Dim::Tof},
+                                      Shape{2, 3, Dimensions::Sparse},
+                                      units::Unit(units::us), Values{},
+                                      Variances{});
+};
+
+TEST_F(PackedEventsTest, pack) {
+  const auto packed = sparse::pack(var);
+  EXPECT_EQ(packed.dims(), var.dims());
+  EXPECT_EQ(packed.dtype(), dtype<double>);
+  EXPECT_EQ(packed.unit(), units::us);
+  EXPECT_TRUE(packed.hasVariances());
+  EXPECT_EQ(packed.begin(), makeVariable<scipp::index>(
+                                Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                Values{0, 3, 3, 5, 6, 10}));
+  EXPECT_EQ(packed.end(), makeVariable<scipp::index>(
+                              Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                              Values{3, 3, 5, 6, 10, 12}));
+  EXPECT_EQ(packed.buffer(),
+            makeVariable<double>(
+                Dims{Dim::Tof}, Shape{12}, units::Unit(units::us),
+                Values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+                Variances{1, 1, 1, 2, 2, 3, 4, 4, 4, 4, 5, 5}));
+}
+
+TEST_F(PackedEventsTest, unpack) {
+  EXPECT_EQ(sparse::unpack(sparse::pack(var)), var);
+  EXPECT_EQ(sparse::unpack(sparse::pack(var.slice({Dim::X, 1, 3}))),
+            var.slice({Dim::X, 1, 3}));
+}
+
+TEST_F(PackedEventsTest, pack_without_variances) {
+  const auto values = sparse::pack(var).buffer().values<double>();
+  Variable noVariances(var);
+  noVariances.setVariances(Variable());
+  const auto packed = sparse::pack(noVariances);
+  EXPECT_FALSE(packed.hasVariances());
+  EXPECT_TRUE(equals(packed.buffer().values<double>(), values));
+  EXPECT_EQ(sparse::unpack(packed), noVariances);
+}
+
+TEST_F(PackedEventsTest, pack_int) {
+  auto ints = makeVariable<int32_t>(Dims{Dim::X, Dim::Tof},
+                                    Shape{2, Dimensions::Sparse});
+  ints.sparseValues<int32_t>()[1] = {1, 2};
+  EXPECT_EQ(sparse::unpack(sparse::pack(ints)), ints);
+}
+
+TEST_F(PackedEventsTest, pack_dense_fails) {
+  ASSERT_THROW_NODISCARD(
+      sparse::pack(makeVariable<double>(Dims{Dim::X}, Shape{2})),
+      except::DimensionError);
+}
+
+TEST_F(PackedEventsTest, construct_bad_range_fails) {
+  const auto packed = sparse::pack(var);
+  auto end = packed.end();
+  end.values<scipp::index>()[5] = 13;
+  EXPECT_THROW(PackedEvents(packed.begin(), end, packed.buffer()),
+               except::SliceError);
+  end.values<scipp::index>()[5] = 9;
+  EXPECT_THROW(PackedEvents(packed.begin(), end, packed.buffer()),
+               except::SliceError);
+  EXPECT_THROW(PackedEvents(packed.begin(), packed.end(),
+                            makeVariable<double>(Dims{Dim::X}, Shape{12})),
+               except::DimensionError);
+}
+
+TEST_F(PackedEventsTest, from_offsets) {
+  const auto offsets =
+      makeVariable<scipp::index>(Dims{Dim::X}, Shape{4}, Values{0, 2, 2, 5});
+  const auto buffer = makeVariable<float>(Dims{Dim::Tof}, Shape{5},
+                                          units::Unit(units::us),
+                                          Values{1, 2, 3, 4, 5});
+  const auto packed = sparse::from_offsets(offsets, buffer);
+  auto expected = makeVariable<float>(Dims{Dim::X, Dim::Tof},
+                                      Shape{3, Dimensions::Sparse},
+                                      units::Unit(units::us));
+  auto vals = expected.sparseValues<float>();
+  vals[0] = {1, 2};
+  vals[2] = {3, 4, 5};
+  EXPECT_EQ(sparse::unpack(packed), expected);
+  EXPECT_EQ(sparse::offsets(packed), offsets);
+}
+
+TEST_F(PackedEventsTest, from_offsets_bad_offsets_fails) {
+  const auto buffer = makeVariable<double>(Dims{Dim::Tof}, Shape{5});
+  ASSERT_THROW_NODISCARD(
+      sparse::from_offsets(makeVariable<scipp::index>(Dims{Dim::X}, Shape{0}),
+                           buffer),
+      except::SizeError);
+  ASSERT_THROW_NODISCARD(
+      sparse::from_offsets(makeVariable<scipp::index>(Dims{Dim::X}, Shape{3},
+                                                      Values{0, 3, 2}),
+                           buffer),
+      except::SliceError);
+  ASSERT_THROW_NODISCARD(
+      sparse::from_offsets(makeVariable<scipp::index>(Dims{Dim::X}, Shape{3},
+                                                      Values{0, 3, 6}),
+                           buffer),
+      except::SliceError);
+}
+
+TEST_F(PackedEventsTest, offsets) {
+  const auto packed = flatten(sparse::pack(var), Dim::Y);
+  EXPECT_EQ(sparse::offsets(packed),
+            makeVariable<scipp::index>(Dims{Dim::X}, Shape{4},
+                                       Values{0, 4, 8, 12}));
+  const auto sliced = packed.slice({Dim::X, 1, 3});
+  ASSERT_THROW_NODISCARD(sparse::offsets(sliced), except::SliceError);
+  EXPECT_EQ(sparse::offsets(copy(sliced)),
+            makeVariable<scipp::index>(Dims{Dim::X}, Shape{3},
+                                       Values{0, 4, 8}));
+  ASSERT_THROW_NODISCARD(sparse::offsets(sparse::pack(var)),
+                         except::DimensionError);
+}
+
+TEST_F(PackedEventsTest, slice) {
+  const auto packed = sparse::pack(var);
+  const auto slice = packed.slice({Dim::X, 1, 3});
+  EXPECT_EQ(&slice.buffer(), &packed.buffer());
+  EXPECT_EQ(sparse::unpack(slice), var.slice({Dim::X, 1, 3}));
+  EXPECT_EQ(sparse::unpack(packed.slice({Dim::Y, 1})), var.slice({Dim::Y, 1}));
+  EXPECT_THROW(packed.slice({Dim::Tof, 0}), except::DimensionError);
+}
+
+TEST_F(PackedEventsTest, copy) {
+  const auto packed = sparse::pack(var);
+  const auto copied = copy(packed);
+  EXPECT_EQ(copied, packed);
+  EXPECT_NE(&copied.buffer(), &packed.buffer());
+
+  // Contiguous range of buffer.
+  const auto outer = copy(packed.slice({Dim::Y, 1}));
+  EXPECT_EQ(outer, packed.slice({Dim::Y, 1}));
+  EXPECT_EQ(outer.buffer().dims().volume(), 7);
+  EXPECT_EQ(outer.begin().values<scipp::index>()[0], 0);
+
+  // Non-contiguous ranges.
+  const auto inner = copy(packed.slice({Dim::X, 0}));
+  EXPECT_EQ(inner, packed.slice({Dim::X, 0}));
+  EXPECT_TRUE(equals(inner.buffer().values<double>(), {1, 2, 3, 6}));
+  EXPECT_TRUE(equals(inner.buffer().variances<double>(), {1, 1, 1, 3}));
+}
+
+TEST_F(PackedEventsTest, comparison) {
+  const auto packed = sparse::pack(var);
+  EXPECT_EQ(packed, sparse::pack(var));
+  EXPECT_NE(packed, packed.slice({Dim::Y, 0, 1}));
+  Variable modified(var);
+  modified.sparseValues<double>()[4][2] = 0.0;
+  EXPECT_NE(packed, sparse::pack(modified));
+  modified = var;
+  modified.sparseVariances<double>()[4][2] = 0.0;
+  EXPECT_NE(packed, sparse::pack(modified));
+  modified = var;
+  modified.setUnit(units::m);
+  EXPECT_NE(packed, sparse::pack(modified));
+}
+
+TEST_F(PackedEventsTest, flatten) {
+  const auto packed = sparse::pack(var);
+  EXPECT_EQ(sparse::unpack(flatten(packed, Dim::X)), flatten(var, Dim::X));
+  EXPECT_EQ(sparse::unpack(flatten(packed, Dim::Y)), flatten(var, Dim::Y));
+  EXPECT_EQ(sparse::unpack(flatten(packed.slice({Dim::X, 1, 3}), Dim::Y)),
+            flatten(var.slice({Dim::X, 1, 3}), Dim::Y));
+  ASSERT_THROW_NODISCARD(flatten(packed, Dim::Z), except::DimensionError);
+}
+
+TEST_F(PackedEventsTest, view) {
+  const auto packed = sparse::pack(var);
+  const auto view = packed.view();
+  EXPECT_EQ(view.dims(), packed.begin().dims());
+  EXPECT_EQ(view.unit(), units::us);
+  const auto values = view.values<span<const double>>();
+  const auto variances = view.variances<span<const double>>();
+  EXPECT_TRUE(equals(values[2], {4, 5}));
+  EXPECT_TRUE(equals(variances[4], {4, 4, 4, 4}));
+  EXPECT_TRUE(values[1].empty());
+  EXPECT_EQ(values[5].data(), packed.buffer().values<double>().data() + 10);
+}
+
+TEST_F(PackedEventsTest, histogram) {
+  const auto edges = makeVariable<double>(Dims{Dim::Tof}, Shape{4},
+                                          units::Unit(units::us),
+                                          Values{0.0, 2.0, 5.0, 10.0});
+  Variable coord(var);
+  coord.setVariances(Variable());
+  const auto packed = sparse::pack(coord);
+  const DataArray array(std::nullopt, {{Dim::Tof, coord}});
+  const auto expected = Variable(core::histogram(array, edges).data());
+  EXPECT_EQ(histogram(packed, edges), expected);
+  EXPECT_EQ(histogram(packed.slice({Dim::X, 1, 3}), edges),
+            expected.slice({Dim::X, 1, 3}));
+  ASSERT_THROW_NODISCARD(histogram(sparse::pack(var), edges),
+                         except::VariancesError);
+}
@@ -61,6 +61,24 @@ TEST_F(RebinTest, inner_data_array_unaligned_edges) {
   ASSERT_EQ(rebin(array, Dim::X, edges), expected);
 }
 
+TEST_F(RebinTest, inner_data_array_2d_edges) {
+  auto edges = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                    Values{1, 3, 5, 1, 2, 5});
+  DataArray expected(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 2},
+                                          units::Unit(units::counts),
+                                          Values{3, 7, 5, 21},
+                                          Variances{19, 23, 13, 45}),
+                     {{Dim::X, edges}, {Dim::Y, y}}, {});
+
+  ASSERT_EQ(rebin(array_with_variances, Dim::X, edges), expected);
+}
+
+TEST_F(RebinTest, inner_data_array_2d_edges_unrelated_dimension_fail) {
+  auto edges = makeVariable<double>(Dims{Dim::Z, Dim::X}, Shape{2, 3},
+                                    Values{1, 3, 5, 1, 2, 5});
+  EXPECT_THROW(rebin(array, Dim::X, edges), std::runtime_error);
+}
+
 TEST_F(RebinTest, outer_data_array) {
   auto edges = makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{1, 3});
   DataArray expected(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{1, 4},
@@ -107,6 +125,69 @@ TEST_F(RebinTest, outer_data_array_unaligned_edges) {
   ASSERT_EQ(rebin(array, Dim::Y, edges), expected);
 }
 
+TEST_F(RebinTest, outer_data_array_unaligned_edges_with_variances) {
+  auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{1.0, 2.5, 3.5});
+  const auto rebinned = rebin(array_with_variances, Dim::Y, edges);
+  // Variances are rebinned with the same weights as values, as for the inner
+  // dimension.
+  EXPECT_EQ(rebinned.data(),
+            makeVariable<double>(
+                Dims{Dim::Y, Dim::X}, Shape{2, 4}, units::Unit(units::counts),
+                Values{1.0 + 0.5 * 5, 2.0 + 0.5 * 6, 3.0 + 0.5 * 7,
+                       4.0 + 0.5 * 8, 0.5 * 5, 0.5 * 6, 0.5 * 7, 0.5 * 8},
+                Variances{9 + 0.5 * 13, 10 + 0.5 * 14, 11 + 0.5 * 15,
+                          12 + 0.5 * 16, 0.5 * 13, 0.5 * 14, 0.5 * 15,
+                          0.5 * 16}));
+}
+
+TEST_F(RebinTest, outer_data_array_slice) {
+  auto edges = makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{1, 3});
+  DataArray expected(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{1, 2},
+                                          units::Unit(units::counts),
+                                          Values{8, 10}),
+                     {{Dim::X, Variable(x.slice({Dim::X, 1, 4}))},
+                      {Dim::Y, edges}},
+                     {});
+
+  ASSERT_EQ(rebin(array.slice({Dim::X, 1, 3}), Dim::Y, edges), expected);
+}
+
+TEST_F(RebinTest, outer_data_array_2d_edges) {
+  // Edges for Dim::Y depend on the inner dimension Dim::X.
+  auto edges = makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{4, 2},
+                                    Values{1, 3, 1, 3, 1, 2, 2, 3});
+  DataArray expected(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{1, 4},
+                                          units::Unit(units::counts),
+                                          Values{6, 8, 3, 8}),
+                     {{Dim::X, x}, {Dim::Y, edges}}, {});
+
+  ASSERT_EQ(rebin(array, Dim::Y, edges), expected);
+}
+
+TEST_F(RebinTest, outer_3d_with_2d_edges) {
+  // Edges for Dim::Y depend on the outer dimension Dim::Z.
+  const auto data = makeVariable<double>(
+      Dims{Dim::Z, Dim::Y, Dim::X}, Shape{2, 2, 2}, units::Unit(units::counts),
+      Values{1, 2, 3, 4, 5, 6, 7, 8}, Variances{1, 2, 3, 4, 5, 6, 7, 8});
+  const auto oldEdges = makeVariable<double>(Dims{Dim::Z, Dim::Y}, Shape{2, 3},
+                                             Values{0, 1, 2, 0, 2, 4});
+  const auto newEdges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{0.0, 0.5, 2.0});
+  EXPECT_EQ(rebin(data, Dim::Y, oldEdges, newEdges),
+            makeVariable<double>(Dims{Dim::Z, Dim::Y, Dim::X}, Shape{2, 2, 2},
+                                 units::Unit(units::counts),
+                                 Values{0.5, 1.0, 3.5, 5.0, 1.25, 1.5, 3.75, 4.5},
+                                 Variances{0.5, 1.0, 3.5, 5.0, 1.25, 1.5,
+                                           3.75, 4.5}));
+}
+
+TEST_F(RebinTest, outer_edges_with_unrelated_dimension_fail) {
+  const auto edges = makeVariable<double>(Dims{Dim::Z, Dim::Y}, Shape{2, 2},
+                                          Values{1, 3, 1, 3});
+  EXPECT_THROW(rebin(counts, Dim::Y, y, edges), except::DimensionError);
+}
+
 TEST_F(RebinTest, keeps_unrelated_labels_but_drops_others) {
   const auto labels_x = makeVariable<double>(Dims{Dim::X}, Shape{4});
   const auto labels_y = makeVariable<double>(Dims{Dim::Y}, Shape{2});
@@ -176,3 +257,16 @@ TEST_F(RebinMask2DTest, mask_weights_2d) {
 
   ASSERT_EQ(result, expected);
 }
+
+TEST(RebinMaskOuterTest, mask_outer) {
+  const auto y =
+      makeVariable<double>(Dims{Dim::Y}, Shape{4}, Values{1, 2, 3, 4});
+  const auto mask =
+      makeVariable<bool>(Dims{Dim::Y, Dim::X}, Shape{3, 2},
+                         Values{false, false, true, false, false, false});
+  const auto edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{1.0, 2.5, 4.0});
+  EXPECT_EQ(rebin(mask, Dim::Y, y, edges),
+            makeVariable<bool>(Dims{Dim::Y, Dim::X}, Shape{2, 2},
+                               Values{true, false, true, false}));
+}
@@ -44,3 +44,18 @@ TEST(ReduceTest, min_max_with_variances) {
             makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1, 3},
                                  Variances{5, 7}));
 }
+
+TEST(ReduceTest, min_max_large_parallel) {
+  const scipp::index nx = 1000;
+  const scipp::index ny = 300;
+  auto var = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{ny, nx});
+  auto vals = var.values<double>();
+  for (scipp::index i = 0; i < nx * ny; ++i)
+    vals[i] = (i * 7919) % (nx * ny);
+  const auto flat = Variable(var).reshape({Dim::X, nx * ny});
+  EXPECT_EQ(max(flat, Dim::X),
+            makeVariable<double>(Values{static_cast<double>(nx * ny - 1)}));
+  EXPECT_EQ(min(flat, Dim::X), makeVariable<double>(Values{0.0}));
+  EXPECT_EQ(max(max(var, Dim::X), Dim::Y), max(flat, Dim::X));
+  EXPECT_EQ(min(min(var, Dim::Y), Dim::X), min(flat, Dim::X));
+}
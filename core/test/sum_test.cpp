@@ -79,3 +79,43 @@ TEST_F(Sum2dCoordTest, data_array_bad_2d_labels_fail) {
   // Values being summed have different x labels -> fail.
   EXPECT_THROW(sum(a, Dim::Y), except::CoordMismatchError);
 }
+
+TEST(SumTest, large_parallel) {
+  // Large enough to use parallel reduction, values chosen such that the result
+  // is exact independent of the order of summation.
+  const scipp::index nx = 1000;
+  const scipp::index ny = 300;
+  auto var = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{ny, nx},
+                                  Values{}, Variances{});
+  auto vals = var.values<double>();
+  auto vars = var.variances<double>();
+  for (scipp::index i = 0; i < nx * ny; ++i) {
+    vals[i] = i % nx;
+    vars[i] = i / nx;
+  }
+  auto sumX = makeVariable<double>(Dims{Dim::Y}, Shape{ny}, Values{},
+                                   Variances{});
+  for (scipp::index y = 0; y < ny; ++y) {
+    sumX.values<double>()[y] = nx * (nx - 1) / 2;
+    sumX.variances<double>()[y] = nx * y;
+  }
+  auto sumY = makeVariable<double>(Dims{Dim::X}, Shape{nx}, Values{},
+                                   Variances{});
+  for (scipp::index x = 0; x < nx; ++x) {
+    sumY.values<double>()[x] = ny * x;
+    sumY.variances<double>()[x] = ny * (ny - 1) / 2;
+  }
+  EXPECT_EQ(sum(var, Dim::X), sumX);
+  EXPECT_EQ(sum(var, Dim::Y), sumY);
+  EXPECT_EQ(sum(sum(var, Dim::X), Dim::Y),
+            makeVariable<double>(Values{ny * nx * (nx - 1) / 2},
+                                 Variances{nx * ny * (ny - 1) / 2}));
+}
+
+TEST(SumTest, large_parallel_bool) {
+  auto var = makeVariable<bool>(Dims{Dim::Y, Dim::X}, Shape{300, 1000});
+  auto vals = var.values<bool>();
+  for (scipp::index i = 0; i < 300 * 1000; ++i)
+    vals[i] = i % 3 == 0;
+  EXPECT_EQ(sum(sum(var, Dim::X), Dim::Y), makeVariable<int64_t>(Values{100000}));
+}
@@ -268,6 +268,33 @@ TEST_F(TransformBinaryTest, view_with_view) {
   EXPECT_TRUE(equals(a.values<double>(), {1.1, 2.2 * 3.3}));
 }
 
+TEST_F(TransformBinaryTest, strided_and_broadcast_views) {
+  auto a = makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{3, 4},
+      Values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12},
+      Variances{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1});
+  const auto b =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{4, 3},
+                           Values{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+  const auto c =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4});
+  // Rows of the slice of `a` are contiguous but not adjacent, `b` is
+  // transposed, i.e., has a non-unit inner stride, and `c` is broadcast.
+  const auto a_slice = a.slice({Dim::X, 1, 4});
+  const auto b_slice = b.slice({Dim::X, 0, 3});
+  const auto c_slice = c.slice({Dim::X, 1, 4});
+
+  const auto ab = transform<pair_self_t<double>>(a_slice, b_slice, op);
+  const auto abc = transform<pair_self_t<double>>(ab, c_slice, op);
+  EXPECT_TRUE(equals(abc.values<double>(),
+                     {4, 36, 112, 24, 105, 256, 60, 198, 432}));
+
+  transform_in_place<pair_self_t<double>>(a_slice, b_slice, op_in_place);
+  transform_in_place<pair_self_t<double>>(a_slice, c_slice, op_in_place);
+  EXPECT_EQ(a_slice, abc);
+  EXPECT_TRUE(equals(a.slice({Dim::X, 0}).values<double>(), {1, 5, 9}));
+}
+
 TEST_F(TransformBinaryTest, dense_sparse) {
   auto sparse =
       makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2l, Dimensions::Sparse});
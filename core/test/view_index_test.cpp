@@ -44,6 +44,20 @@ TEST_F(ViewIndex2DTest, construct) {
   EXPECT_NO_THROW(ViewIndex(xy, yx));
 }
 
+TEST_F(ViewIndex2DTest, extent) {
+  ViewIndex i(xy, xy);
+  EXPECT_EQ(i.extent(0), 3);
+  EXPECT_EQ(i.extent(1), 5);
+}
+
+TEST_F(ViewIndex2DTest, outer_strided_dim) {
+  EXPECT_EQ(ViewIndex(xy, xy).outer_strided_dim(), 1);
+  EXPECT_EQ(ViewIndex(xy, yx).outer_strided_dim(), 1);
+  EXPECT_EQ(ViewIndex(xy, x).outer_strided_dim(), 0);
+  EXPECT_EQ(ViewIndex(xy, y).outer_strided_dim(), 1);
+  EXPECT_EQ(ViewIndex(xy, none).outer_strided_dim(), -1);
+}
+
 TEST_F(ViewIndex2DTest, setIndex_2D) {
   ViewIndex i(xy, xy);
   EXPECT_EQ(i.get(), 0);
@@ -182,3 +196,25 @@ TEST_F(ViewIndex2DTest, edges) {
   i.increment();
   EXPECT_EQ(i.get(), 18);
 }
+
+TEST_F(ViewIndex2DTest, increment_inner) {
+  ViewIndex i(xy, yx);
+  EXPECT_EQ(i.inner_remaining(), 3);
+  EXPECT_EQ(i.inner_stride(), 5);
+  i.increment_inner(2);
+  EXPECT_EQ(i.get(), 10);
+  EXPECT_EQ(i.index(), 2);
+  EXPECT_EQ(i.inner_remaining(), 1);
+  i.increment_inner(1);
+  EXPECT_EQ(i.get(), 1);
+  EXPECT_EQ(i.index(), 3);
+  EXPECT_EQ(i.inner_remaining(), 3);
+}
+
+TEST_F(ViewIndex2DTest, increment_inner_0D) {
+  ViewIndex i(Dimensions{}, none);
+  EXPECT_EQ(i.inner_remaining(), 1);
+  i.increment_inner(1);
+  EXPECT_EQ(i.get(), 0);
+  EXPECT_EQ(i.index(), 1);
+}
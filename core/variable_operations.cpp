@@ -7,6 +7,8 @@
 #include "scipp/core/apply.h"
 #include "scipp/core/dtype.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
 #include "scipp/core/transform.h"
 #include "scipp/core/variable.h"
 
@@ -103,6 +105,121 @@ Variable concatenate(const VariableConstView &a1, const VariableConstView &a2,
   return out;
 }
 
+/// Return ranges [begin, end) of consecutive indices in `indices`.
+///
+/// Used for merging copies of adjacent slices into a single bulk copy.
+std::vector<IndexRange>
+contiguous_ranges(const std::vector<scipp::index> &indices) {
+  std::vector<IndexRange> ranges;
+  for (const auto index : indices) {
+    if (!ranges.empty() && ranges.back().second == index)
+      ++ranges.back().second;
+    else
+      ranges.emplace_back(index, index + 1);
+  }
+  return ranges;
+}
+
+namespace {
+using gather_types =
+    std::tuple<double, float, int64_t, int32_t, bool, std::string,
+               sparse_container<double>, sparse_container<float>,
+               sparse_container<int64_t>, sparse_container<int32_t>>;
+
+template <class... Ts>
+bool is_gather_type(const std::tuple<Ts...> &, const DType dtype) {
+  return ((dtype == core::dtype<Ts>) || ...);
+}
+
+/// Gather from contiguous data, bypassing the element views used by the
+/// generic VariableConcept::copy, which dominate for short ranges.
+template <class T> struct GatherContiguous {
+  template <class Out, class In>
+  static void copy_blocks(Out &&out, const In &in, const Dimensions &dims,
+                          const Dim dim, const std::vector<IndexRange> &ranges,
+                          const std::vector<scipp::index> &offsets) {
+    const auto stride = dims.offset(dim);
+    const auto extent = dims[dim];
+    const auto size = offsets.back();
+    const auto outer = extent == 0 ? 0 : dims.volume() / (extent * stride);
+    parallel::parallel_for(
+        parallel::blocked_range(0, scipp::size(ranges)),
+        [&](const auto &range) {
+          for (scipp::index o = 0; o < outer; ++o)
+            for (auto i = range.begin(); i < range.end(); ++i)
+              std::copy(in.begin() + (o * extent + ranges[i].first) * stride,
+                        in.begin() + (o * extent + ranges[i].second) * stride,
+                        out.begin() + (o * size + offsets[i]) * stride);
+        });
+  }
+
+  static void apply(VariableConcept &out, const VariableConcept &in,
+                    const Dim dim, const std::vector<IndexRange> &ranges,
+                    const std::vector<scipp::index> &offsets) {
+    auto &outT = dynamic_cast<VariableConceptT<T> &>(out);
+    const auto &inT = dynamic_cast<const VariableConceptT<T> &>(in);
+    copy_blocks(outT.values(), inT.values(), in.dims(), dim, ranges, offsets);
+    if (in.hasVariances())
+      copy_blocks(outT.variances(), inT.variances(), in.dims(), dim, ranges,
+                  offsets);
+  }
+};
+} // namespace
+
+Variable gather(const VariableConstView &var, const Dim dim,
+                const std::vector<IndexRange> &ranges,
+                const scipp::index size) {
+  auto dims = var.dims();
+  dims.resize(dim, size);
+  Variable out(var, dims);
+  std::vector<scipp::index> offsets(ranges.size() + 1, 0);
+  for (scipp::index i = 0; i < scipp::size(ranges); ++i)
+    offsets[i + 1] = offsets[i] + ranges[i].second - ranges[i].first;
+  auto &concept = out.data();
+  const auto &source = var.data();
+  if (source.isContiguous() &&
+      is_gather_type(gather_types{}, source.dtype())) {
+    callDType<GatherContiguous>(gather_types{}, source.dtype(), concept,
+                                source, dim, ranges, offsets);
+    return out;
+  }
+  // Output ranges are disjoint, so copies can run concurrently.
+  parallel::parallel_for(
+      parallel::blocked_range(0, scipp::size(ranges)), [&](const auto &range) {
+        for (auto i = range.begin(); i < range.end(); ++i)
+          concept.copy(source, dim, offsets[i], ranges[i].first,
+                       ranges[i].second);
+      });
+  return out;
+}
+
+/// Gather bin-edges, checking that the edges of neighboring output bins match.
+Variable gather_edges(const VariableConstView &var, const Dim dim,
+                      const std::vector<IndexRange> &ranges,
+                      const scipp::index size) {
+  auto dims = var.dims();
+  dims.resize(dim, size + 1);
+  Variable out(var, dims);
+  scipp::index offset = 0;
+  for (const auto &[begin, end] : ranges) {
+    if (offset != 0)
+      expect::equals(out.slice({dim, offset}), var.slice({dim, begin}));
+    out.data().copy(var.data(), dim, offset, begin, end + 1);
+    offset += end - begin;
+  }
+  return out;
+}
+
+/// Return a Variable containing the slices of `var` along `dim` given by
+/// `indices`, in the order given by `indices`.
+///
+/// The output is allocated once and runs of consecutive indices are copied in
+/// bulk, i.e., this has linear complexity, unlike repeated `concatenate`.
+Variable gather(const VariableConstView &var, const Dim dim,
+                const std::vector<scipp::index> &indices) {
+  return gather(var, dim, contiguous_ranges(indices), scipp::size(indices));
+}
+
 Variable permute(const Variable &var, const Dim dim,
                  const std::vector<scipp::index> &indices) {
   auto permuted(var);
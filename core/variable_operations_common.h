@@ -5,6 +5,9 @@
 #ifndef SCIPP_CORE_VARIABLE_OPERATIONS_COMMON_H
 #define SCIPP_CORE_VARIABLE_OPERATIONS_COMMON_H
 
+#include <utility>
+#include <vector>
+
 #include "scipp/core/variable.h"
 
 namespace scipp::core {
@@ -13,11 +16,23 @@ namespace scipp::core {
 void flatten_impl(const VariableView &summed, const VariableConstView &var,
                   const VariableConstView &mask);
 void sum_impl(const VariableView &summed, const VariableConstView &var);
+void sum_impl(const VariableView &summed, const VariableConstView &var,
+              const VariableConstView &mask);
 void all_impl(const VariableView &out, const VariableConstView &var);
 void any_impl(const VariableView &out, const VariableConstView &var);
 void max_impl(const VariableView &out, const VariableConstView &var);
 void min_impl(const VariableView &out, const VariableConstView &var);
 
+// Helpers for gathering slices, used by `gather` for Variable and DataArray.
+using IndexRange = std::pair<scipp::index, scipp::index>;
+std::vector<IndexRange>
+contiguous_ranges(const std::vector<scipp::index> &indices);
+Variable gather(const VariableConstView &var, const Dim dim,
+                const std::vector<IndexRange> &ranges, const scipp::index size);
+Variable gather_edges(const VariableConstView &var, const Dim dim,
+                      const std::vector<IndexRange> &ranges,
+                      const scipp::index size);
+
 } // namespace scipp::core
 
 #endif // SCIPP_CORE_VARIABLE_OPERATIONS_COMMON_H
@@ -4,6 +4,7 @@
 /// @author Simon Heybrock
 #include "scipp/core/dtype.h"
 #include "scipp/core/except.h"
+#include "scipp/core/parallel.h"
 #include "scipp/core/transform.h"
 #include "scipp/core/variable.h"
 #include "scipp/core/view_decl.h"
@@ -112,14 +113,107 @@ Variable flatten(const VariableConstView &var, const Dim dim,
   return flattened;
 }
 
+namespace {
+/// Number of chunks used when reducing to a small output. This is independent
+/// of the number of threads to ensure reproducible results.
+constexpr scipp::index reduction_chunks = 24;
+/// Minimum input volume for which a reduction to a small output is chunked.
+constexpr scipp::index reduction_min_volume = 65536;
+
+/// Return the dimension for computing a reduction of `var` into `out` in chunks
+/// with private partial results, or Dim::Invalid if this is not beneficial.
+///
+/// accumulate_in_place parallelizes over output elements, i.e., it cannot make
+/// use of multiple threads if the output is small, such as for a full
+/// reduction to a scalar.
+Dim chunked_reduction_dim(const VariableConstView &out,
+                          const VariableConstView &var) {
+  if (var.dims().sparse() || out.dims().volume() >= reduction_chunks ||
+      var.dims().volume() < reduction_min_volume)
+    return Dim::Invalid;
+  const auto dims = var.dims();
+  for (const auto dim : dims.denseLabels())
+    if (!out.dims().contains(dim) && dims[dim] >= reduction_chunks)
+      return dim;
+  return Dim::Invalid;
+}
+
+/// Reduce `var` into `out` using chunks of `var` along a reduced dimension.
+///
+/// Each chunk is reduced into a partial result obtained from `init(out)`, and
+/// the partial results are then combined into `out` in a fixed order. Returns
+/// false if the reduction was not done since chunking is not beneficial.
+template <class Init, class Reduce>
+bool reduce_chunked(const VariableView &out, const VariableConstView &var,
+                    Init init, Reduce reduce) {
+  const auto dim = chunked_reduction_dim(out, var);
+  if (dim == Dim::Invalid)
+    return false;
+  const auto size = var.dims()[dim];
+  std::vector<Variable> partials(reduction_chunks);
+  parallel::parallel_for(
+      parallel::blocked_range(0, reduction_chunks, 1), [&](const auto &range) {
+        for (auto i = range.begin(); i < range.end(); ++i) {
+          partials[i] = init(out);
+          reduce(partials[i], var.slice({dim, i * size / reduction_chunks,
+                                         (i + 1) * size / reduction_chunks}));
+        }
+      });
+  for (auto &partial : partials)
+    reduce(out, partial);
+  return true;
+}
+} // namespace
+
+namespace {
+void accumulate_sum(const VariableView &summed, const VariableConstView &var) {
+  accumulate_in_place<
+      pair_self_t<double, float, int64_t, int32_t, Eigen::Vector3d>,
+      pair_custom_t<std::pair<int64_t, bool>, std::pair<double, int64_t>,
+                    std::pair<double, int32_t>>>(
+      summed, var, [](auto &&a, auto &&b) { a += b; });
+}
+} // namespace
+
 void sum_impl(const VariableView &summed, const VariableConstView &var) {
   if (var.dims().sparse())
     throw except::DimensionError("`sum` can only be used for dense data, use "
                                  "`flatten` for sparse data.");
-  accumulate_in_place<
-      pair_self_t<double, float, int64_t, int32_t, Eigen::Vector3d>,
-      pair_custom_t<std::pair<int64_t, bool>>>(
-      summed, var, [](auto &&a, auto &&b) { a += b; });
+  const auto zeros = [](const VariableConstView &out) {
+    return Variable(out, out.dims());
+  };
+  if (!reduce_chunked(summed, var, zeros, accumulate_sum))
+    accumulate_sum(summed, var);
+}
+
+namespace sum_masked_detail {
+template <class Out, class In> using args = std::tuple<Out, In, bool>;
+}
+
+/// Add elements of `var` to `summed` where `mask` is true.
+///
+/// Integer input may be summed into floating-point output, avoiding a
+/// conversion of the input in reductions such as `mean`. Unlike `sum_impl` on
+/// the product of `var` and `mask`, this does not create a temporary.
+void sum_impl(const VariableView &summed, const VariableConstView &var,
+              const VariableConstView &mask) {
+  if (var.dims().sparse())
+    throw except::DimensionError("`sum` can only be used for dense data, use "
+                                 "`flatten` for sparse data.");
+  using namespace sum_masked_detail;
+  accumulate_in_place<std::tuple<
+      args<double, double>, args<float, float>, args<int64_t, int64_t>,
+      args<int32_t, int32_t>, args<double, int64_t>, args<double, int32_t>>>(
+      summed, var, mask,
+      overloaded{[](auto &a, const auto &b, const auto &mask_) {
+                   if (mask_)
+                     a += b;
+                 },
+                 [](units::Unit &a, const units::Unit &b,
+                    const units::Unit &mask_) {
+                   expect::equals(mask_, units::dimensionless);
+                   a += b;
+                 }});
 }
 
 Variable sum(const VariableConstView &var, const Dim dim) {
@@ -240,7 +334,17 @@ VariableView mean(const VariableConstView &var, const Dim dim,
 template <class Op>
 void reduce_impl(const VariableView &out, const VariableConstView &var) {
   expect::notSparse(var);
-  accumulate_in_place(out, var, Op{});
+  const auto accumulate = [](const VariableView &out_,
+                              const VariableConstView &var_) {
+    accumulate_in_place(out_, var_, Op{});
+  };
+  // Partial results start as copy of `out`, which is valid since all `Op` used
+  // here are idempotent.
+  const auto copy_out = [](const VariableConstView &out_) {
+    return copy(out_);
+  };
+  if (!reduce_chunked(out, var, copy_out, accumulate))
+    accumulate(out, var);
 }
 
 /// Reduction for idempotent operations such that op(a,a) = a.
@@ -0,0 +1,67 @@
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+# @file
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
+import scipp as sc
+from scipp import Dim
+import numpy as np
+
+
+def reduction_pipeline(size, n_iterations):
+    """
+    Typical O(N) operations of a reduction workflow. None of these should hold
+    the GIL, so independent pipelines on separate Python threads can run
+    concurrently.
+    """
+    a = np.arange(size, dtype=np.float64)
+    var = sc.Variable([Dim.X], values=a)
+    x = sc.Variable([Dim.X], values=a)
+    data = sc.DataArray(data=var, coords={Dim.X: x})
+    for _ in range(n_iterations):
+        var.values = a
+        var *= 2.0
+        var += 1.0
+        data[Dim.X, 0:size // 2] = var[Dim.X, size // 2:size]
+        sc.sum(data, Dim.X)
+        sc.sqrt(var)
+
+
+def run(n_threads, size, n_iterations):
+    with ThreadPoolExecutor(max_workers=n_threads) as pool:
+        start_time = time.perf_counter()
+        futures = [
+            pool.submit(reduction_pipeline, size, n_iterations)
+            for _ in range(n_threads)
+        ]
+        for future in futures:
+            future.result()
+        end_time = time.perf_counter()
+    return end_time - start_time
+
+
+def pipelines_in_threads(size, n_iterations=20):
+    # Warm up, e.g., to initialize the thread pool of scipp.
+    run(1, size, 1)
+    results = []
+    single = run(1, size, n_iterations)
+    for n_threads in range(1, (os.cpu_count() or 1) + 1):
+        total_time = run(n_threads, size, n_iterations)
+        # Ideal (linear) scaling keeps the time constant since every thread
+        # runs its own pipeline.
+        speedup = n_threads * single / total_time
+        results.append({
+            'n_elements': size,
+            'n_threads': n_threads,
+            'time': total_time,
+            'speedup': speedup,
+            'efficiency': speedup / n_threads,
+        })
+    return results
+
+
+if __name__ == '__main__':
+    for size in [1e4, 1e5, 1e6]:
+        for result in pipelines_in_threads(int(size)):
+            print('pipelines_in_threads', result)
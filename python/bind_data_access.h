@@ -181,6 +181,7 @@ template <class... Ts> class as_ElementArrayViewImpl {
               throw except::DimensionError("The shape of the provided data "
                                            "does not match the existing "
                                            "object.");
+            py::gil_scoped_release release;
             copy_flattened<T>(data, view_);
           } else if constexpr (is_sparse_v<T>) {
             auto &data = obj.cast<const py::array_t<typename T::value_type>>();
@@ -192,10 +193,9 @@ template <class... Ts> class as_ElementArrayViewImpl {
                   "only dimension.");
             if (data.ndim() != 1)
               throw except::DimensionError("Expected 1-D data.");
-            auto r = data.unchecked();
-            view_[0].clear();
-            for (ssize_t i = 0; i < r.shape(0); ++i)
-              view_[0].emplace_back(r(i));
+            py::gil_scoped_release release;
+            view_[0].resize(data.shape(0));
+            copy_flattened<typename T::value_type>(data, view_[0]);
           } else {
             const auto &data = obj.cast<const std::vector<T>>();
             // TODO Related to #290, we should properly support
@@ -23,30 +23,48 @@ void bind_in_place_binary(pybind11::class_<T, Ignored...> &c) {
   // in Python (assigning return value to this). This avoids extra copies, and
   // additionally ensures that all references to the object keep referencing the
   // same object after the operation.
+  // The GIL is released only for the operation itself since casting and
+  // returning `a` touch the reference count of the Python object.
   c.def("__iadd__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() += b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self += b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
   c.def("__isub__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() -= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self -= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
   c.def("__imul__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() *= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self *= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
   c.def("__itruediv__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() /= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self /= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
 }
 
 template <class Other, class T, class... Ignored>
@@ -93,22 +111,34 @@ void bind_boolean_operators(pybind11::class_<T, Ignored...> &c) {
         py::call_guard<py::gil_scoped_release>());
   c.def("__ior__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() |= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self |= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
   c.def("__ixor__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() ^= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self ^= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
   c.def("__iand__",
         [](py::object &a, Other &b) {
-          a.cast<T &>() &= b;
+          auto &self = a.cast<T &>();
+          {
+            py::gil_scoped_release release;
+            self &= b;
+          }
           return a;
         },
-        py::is_operator(), py::call_guard<py::gil_scoped_release>());
+        py::is_operator());
 }
 
 #endif // SCIPP_PYTHON_BIND_OPERATORS_H
@@ -69,6 +69,7 @@ template <class View> struct SetData {
             "Shape mismatch when setting data from numpy array.");
 
       auto buf = slice.template values<T>();
+      py::gil_scoped_release release;
       copy_flattened<T>(dataT, buf);
     }
   };
@@ -115,6 +116,7 @@ template <class T> struct slicer {
   static void set(T &self, const std::tuple<Dim, scipp::index> &index,
                   const Other &data) {
     auto slice = slicer<T>::get(self, index);
+    py::gil_scoped_release release;
     slice.assign(data);
   }
 
@@ -122,6 +124,7 @@ template <class T> struct slicer {
   static void set_range(T &self, const std::tuple<Dim, const py::slice> &index,
                         const Other &data) {
     auto slice = slicer<T>::get_range(self, index);
+    py::gil_scoped_release release;
     slice.assign(data);
   }
 };
@@ -16,7 +16,7 @@ void init_counts(py::module &m) {
         [](const DatasetConstView &d, const Dim dim) {
           return counts::toDensity(Dataset(d), dim);
         },
-        py::arg("x"), py::arg("dim"),
+        py::arg("x"), py::arg("dim"), py::call_guard<py::gil_scoped_release>(),
         R"(
         Converts counts to count density on a given dimension.
 
@@ -29,7 +29,7 @@ void init_counts(py::module &m) {
         [](const DataArrayConstView &d, const Dim dim) {
           return counts::toDensity(DataArray(d), dim);
         },
-        py::arg("x"), py::arg("dim"),
+        py::arg("x"), py::arg("dim"), py::call_guard<py::gil_scoped_release>(),
         R"(
         Converts counts to count density on a given dimension.
 
@@ -42,7 +42,7 @@ void init_counts(py::module &m) {
         [](const DatasetConstView &d, const Dim dim) {
           return counts::fromDensity(Dataset(d), dim);
         },
-        py::arg("x"), py::arg("dim"),
+        py::arg("x"), py::arg("dim"), py::call_guard<py::gil_scoped_release>(),
         R"(
         Converts count density to counts on a given dimension.
 
@@ -55,7 +55,7 @@ void init_counts(py::module &m) {
         [](const DataArrayConstView &d, const Dim dim) {
           return counts::fromDensity(DataArray(d), dim);
         },
-        py::arg("x"), py::arg("dim"),
+        py::arg("x"), py::arg("dim"), py::call_guard<py::gil_scoped_release>(),
         R"(
         Converts count density to counts on a given dimension.
 
@@ -98,7 +98,8 @@ void bind_mutable_view(py::module &m, const std::string &name) {
            py::keep_alive<0, 1>())
       .def("__setitem__",
            [](T &self, const typename T::key_type key,
-              const VariableConstView &var) { self.set(key, var); })
+              const VariableConstView &var) { self.set(key, var); },
+           py::call_guard<py::gil_scoped_release>())
       // This additional setitem allows us to do things like
       // d.attrs["a"] = scipp.detail.move(scipp.Variable())
       .def("__setitem__",
@@ -159,7 +160,8 @@ void bind_coord_properties(py::class_<T, Ignored...> &c) {
 template <class T, class... Ignored>
 void bind_dataset_view_methods(py::class_<T, Ignored...> &c) {
   c.def("__len__", &T::size);
-  c.def("__repr__", [](const T &self) { return to_string(self); });
+  c.def("__repr__", [](const T &self) { return to_string(self); },
+        py::call_guard<py::gil_scoped_release>());
   c.def("__iter__",
         [](const T &self) {
           return py::make_iterator(self.keys_begin(), self.keys_end(),
@@ -214,7 +216,8 @@ void bind_dataset_view_methods(py::class_<T, Ignored...> &c) {
 template <class T, class... Ignored>
 void bind_data_array_properties(py::class_<T, Ignored...> &c) {
   c.def_property_readonly("name", &T::name, R"(The name of the held data.)");
-  c.def("__repr__", [](const T &self) { return to_string(self); });
+  c.def("__repr__", [](const T &self) { return to_string(self); },
+        py::call_guard<py::gil_scoped_release>());
   c.def("copy", [](const T &self) { return DataArray(self); },
         py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.");
   c.def("__copy__", [](const T &self) { return DataArray(self); },
@@ -229,7 +232,11 @@ void bind_data_array_properties(py::class_<T, Ignored...> &c) {
             return self.hasData() ? py::cast(self.data()) : py::none();
           },
           py::return_value_policy::move, py::keep_alive<0, 1>()),
-      [](T &self, const VariableConstView &data) { self.data().assign(data); },
+      py::cpp_function(
+          [](T &self, const VariableConstView &data) {
+            self.data().assign(data);
+          },
+          py::call_guard<py::gil_scoped_release>()),
       R"(Underlying data item.)");
   bind_coord_properties(c);
   bind_comparison<DataArrayConstView>(c);
@@ -285,7 +292,8 @@ void init_dataset(py::module &m) {
 
   py::class_<DataArray> dataArray(m, "DataArray", R"(
     Named variable with associated coords, labels, and attributes.)");
-  dataArray.def(py::init<const DataArrayConstView &>());
+  dataArray.def(py::init<const DataArrayConstView &>(),
+                py::call_guard<py::gil_scoped_release>());
   dataArray.def(
       py::init<std::optional<Variable>, std::map<Dim, Variable>,
                std::map<std::string, Variable>, std::map<std::string, Variable>,
@@ -294,7 +302,8 @@ void init_dataset(py::module &m) {
       py::arg("coords") = std::map<Dim, Variable>{},
       py::arg("labels") = std::map<std::string, Variable>{},
       py::arg("masks") = std::map<std::string, Variable>{},
-      py::arg("attrs") = std::map<std::string, Variable>{});
+      py::arg("attrs") = std::map<std::string, Variable>{},
+      py::call_guard<py::gil_scoped_release>());
 
   py::class_<DataArrayConstView>(m, "DataArrayConstView")
       .def(py::init<const DataArray &>());
@@ -319,8 +328,11 @@ void init_dataset(py::module &m) {
   py::class_<Dataset> dataset(m, "Dataset", R"(
     Dict of data arrays with aligned dimensions.)");
 
-  dataset.def(py::init<const std::map<std::string, DataArrayConstView> &>())
-      .def(py::init<const DataArrayConstView &>())
+  dataset
+      .def(py::init<const std::map<std::string, DataArrayConstView> &>(),
+           py::call_guard<py::gil_scoped_release>())
+      .def(py::init<const DataArrayConstView &>(),
+           py::call_guard<py::gil_scoped_release>())
       .def(py::init([](const std::map<std::string, VariableConstView> &data,
                        const std::map<Dim, VariableConstView> &coords,
                        const std::map<std::string, VariableConstView> &labels,
@@ -332,18 +344,22 @@ void init_dataset(py::module &m) {
            py::arg("coords") = std::map<Dim, VariableConstView>{},
            py::arg("labels") = std::map<std::string, VariableConstView>{},
            py::arg("masks") = std::map<std::string, VariableConstView>{},
-           py::arg("attrs") = std::map<std::string, VariableConstView>{})
-      .def(py::init([](const DatasetView &other) { return Dataset{other}; }))
+           py::arg("attrs") = std::map<std::string, VariableConstView>{},
+           py::call_guard<py::gil_scoped_release>())
+      .def(py::init([](const DatasetView &other) { return Dataset{other}; }),
+           py::call_guard<py::gil_scoped_release>())
       .def("__setitem__",
            [](Dataset &self, const std::string &name,
-              const VariableConstView &data) { self.setData(name, data); })
+              const VariableConstView &data) { self.setData(name, data); },
+           py::call_guard<py::gil_scoped_release>())
       .def("__setitem__",
            [](Dataset &self, const std::string &name, MoveableVariable &mvar) {
              self.setData(name, std::move(mvar.var));
            })
       .def("__setitem__",
            [](Dataset &self, const std::string &name,
-              const DataArrayConstView &data) { self.setData(name, data); })
+              const DataArrayConstView &data) { self.setData(name, data); },
+           py::call_guard<py::gil_scoped_release>())
       .def("__setitem__",
            [](Dataset &self, const std::string &name, MoveableDataArray &mdat) {
              self.setData(name, std::move(mdat.data));
@@ -356,7 +372,8 @@ void init_dataset(py::module &m) {
   datasetView.def(
       "__setitem__",
       [](const DatasetView &self, const std::string &name,
-         const DataArrayConstView &data) { self[name].assign(data); });
+         const DataArrayConstView &data) { self[name].assign(data); },
+      py::call_guard<py::gil_scoped_release>());
 
   bind_dataset_view_methods(dataset);
   bind_dataset_view_methods(datasetView);
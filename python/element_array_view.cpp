@@ -14,6 +14,22 @@ using namespace scipp::core;
 
 namespace py = pybind11;
 
+template <class T>
+using c_array_t = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/// Assign the content of a 1-D array to an event list. The array is converted
+/// by pybind11, e.g., from a list, the copy itself does not hold the GIL.
+template <class Events>
+void assign_sparse(Events &events,
+                   const c_array_t<typename Events::value_type> &value) {
+  if (value.ndim() != 1)
+    throw except::DimensionError("Expected 1-D data.");
+  const auto *data = value.data();
+  const auto size = value.size();
+  py::gil_scoped_release release;
+  events.assign(data, data + size);
+}
+
 template <class T> struct mutable_span_methods {
   static void add(py::class_<scipp::span<T>> &span) {
     span.def("__setitem__", [](scipp::span<T> &self, const scipp::index i,
@@ -22,8 +38,8 @@ template <class T> struct mutable_span_methods {
     if constexpr (is_sparse_v<T>)
       span.def("__setitem__",
                [](scipp::span<T> &self, const scipp::index i,
-                  const std::vector<typename T::value_type> &value) {
-                 self[i].assign(value.begin(), value.end());
+                  const c_array_t<typename T::value_type> &value) {
+                 assign_sparse(self[i], value);
                });
   }
 };
@@ -42,7 +58,8 @@ template <class T> void declare_span(py::module &m, const std::string &suffix) {
              return py::make_iterator(self.begin(), self.end());
            })
       .def("__repr__",
-           [](const scipp::span<T> &self) { return array_to_string(self); });
+           [](const scipp::span<T> &self) { return array_to_string(self); },
+           py::call_guard<py::gil_scoped_release>());
   mutable_span_methods<T>::add(span);
 }
 
@@ -52,7 +69,8 @@ void declare_ElementArrayView(py::module &m, const std::string &suffix) {
       m, (std::string("ElementArrayView_") + suffix).c_str());
   view.def(
           "__repr__",
-          [](const ElementArrayView<T> &self) { return array_to_string(self); })
+          [](const ElementArrayView<T> &self) { return array_to_string(self); },
+          py::call_guard<py::gil_scoped_release>())
       .def("__getitem__", &ElementArrayView<T>::operator[],
            py::return_value_policy::reference)
       .def("__setitem__", [](ElementArrayView<T> &self, const scipp::index i,
@@ -64,8 +82,8 @@ void declare_ElementArrayView(py::module &m, const std::string &suffix) {
   if constexpr (is_sparse_v<T>)
     view.def("__setitem__",
              [](const ElementArrayView<T> &self, const scipp::index i,
-                const std::vector<typename T::value_type> &value) {
-               self[i].assign(value.begin(), value.end());
+                const c_array_t<typename T::value_type> &value) {
+               assign_sparse(self[i], value);
              });
 }
 
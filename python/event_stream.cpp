@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "scipp/core/event_stream.h"
+
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace py = pybind11;
+
+void init_event_stream(py::module &m) {
+  m.def("append_events", &sparse::append, py::arg("events"),
+        py::arg("index"), py::arg("batch"),
+        py::call_guard<py::gil_scoped_release>(), R"(
+    Append a batch of events to the event lists of sparse data in place.
+
+    The cost is proportional to the number of appended events, not the number of existing events.
+
+    :param events: Sparse data array to append to.
+    :param index: Flat index of the event list (row-major in the dense dimensions) of each event.
+    :param batch: 1-D data array along the sparse dimension holding the sparse coordinate, the sparse labels, and the weights. The data of `batch` is ignored if `events` has no data.
+    :raises: If the batch does not match the events, in which case `events` is unchanged.)");
+
+  py::class_<EventStream> stream(m, "EventStream", R"(
+    Sparse data that grows by appending batches of events, e.g., pulses from a live acquisition stream.
+
+    Histograms registered with :py:meth:`add_histogram` are updated from the new events of each batch instead of being recomputed.)");
+
+  stream.def(py::init([](const DataArrayConstView &events) {
+               return EventStream(DataArray(events));
+             }),
+             py::arg("events"), py::call_guard<py::gil_scoped_release>(),
+             "Create a stream starting with a copy of the given sparse data.");
+
+  stream.def("append", &EventStream::append, py::arg("index"),
+             py::arg("batch"), py::call_guard<py::gil_scoped_release>(),
+             "Append a batch of events, see :py:func:`scipp.append_events`.");
+
+  stream.def("add_histogram", &EventStream::addHistogram, py::arg("name"),
+             py::arg("bins"), py::call_guard<py::gil_scoped_release>(),
+             "Add a histogram with the given 1-D bin edges, which is kept up "
+             "to date when appending.");
+
+  stream.def_property_readonly(
+      "events",
+      [](const EventStream &self) { return DataArray(self.events()); },
+      py::call_guard<py::gil_scoped_release>(),
+      "Copy of all events appended so far.");
+
+  stream.def(
+      "histogram",
+      [](const EventStream &self, const std::string &name) {
+        return DataArray(self.histogram(name));
+      },
+      py::arg("name"), py::call_guard<py::gil_scoped_release>(),
+      "Copy of the histogram with the given name.");
+}
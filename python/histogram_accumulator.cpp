@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "scipp/core/histogram_accumulator.h"
+#include "scipp/core/except.h"
+
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace py = pybind11;
+
+void init_histogram_accumulator(py::module &m) {
+  py::class_<HistogramAccumulator> accumulator(m, "HistogramAccumulator",
+                                               R"(
+    Histogram of event data that is added in batches.
+
+    Only the histogram is held in memory, such that event data larger than the
+    available memory can be histogrammed by adding it in chunks, e.g., per
+    time interval or per range of spectra. The result is the same as that of
+    :py:func:`scipp.histogram` for all events.)");
+
+  accumulator.def(
+      py::init([](const std::vector<Dim> &labels,
+                  const std::vector<scipp::index> &shape,
+                  const VariableConstView &bins) {
+        if (labels.size() != shape.size())
+          throw except::DimensionError(
+              "Number of dimension labels does not match shape.");
+        Dimensions dims;
+        for (size_t i = 0; i < labels.size(); ++i)
+          dims.addInner(labels[i], shape[i]);
+        return HistogramAccumulator(dims, bins);
+      }),
+      py::arg("dims"), py::arg("shape"), py::arg("bins"),
+      py::call_guard<py::gil_scoped_release>(), R"(
+      Create an empty histogram.
+
+      :param dims: Dense dimensions of the histogram, i.e., the dimensions of the event lists.
+      :param shape: Shape of the dense dimensions.
+      :param bins: 1-D bin edges. Their dimension is the sparse dimension of the events.)");
+
+  accumulator.def(
+      "add",
+      [](HistogramAccumulator &self, const DataArrayConstView &events) {
+        self.add(events);
+      },
+      py::arg("events"), py::call_guard<py::gil_scoped_release>(), R"(
+      Add sparse data with the same dense dimensions as the histogram.
+
+      :param events: Sparse data array with coordinate for the dimension of the bin edges and optional weights.)");
+
+  accumulator.def(
+      "add",
+      [](HistogramAccumulator &self, const DataArrayConstView &events,
+         const Dim dim, const scipp::index begin, const scipp::index end) {
+        self.add(events, Slice{dim, begin, end});
+      },
+      py::arg("events"), py::arg("dim"), py::arg("begin"), py::arg("end"),
+      py::call_guard<py::gil_scoped_release>(), R"(
+      Add sparse data for the range [begin, end) of dimension `dim` of the histogram, e.g., a chunk of spectra.
+
+      :param events: Sparse data array with coordinate for the dimension of the bin edges and optional weights.)");
+
+  accumulator.def(
+      "add",
+      [](HistogramAccumulator &self, const VariableConstView &index,
+         const VariableConstView &coord,
+         const std::optional<VariableConstView> &weights) {
+        self.add(index, coord, weights);
+      },
+      py::arg("index"), py::arg("coord"), py::arg("weights") = std::nullopt,
+      py::call_guard<py::gil_scoped_release>(), R"(
+      Add events given as flat 1-D arrays of equal length.
+
+      :param index: Flat index of the event list (row-major in the dense dimensions) of each event.
+      :param coord: Coordinate of each event.
+      :param weights: Optional weights with variances.)");
+
+  accumulator.def_property_readonly(
+      "result",
+      [](const HistogramAccumulator &self) { return DataArray(self.result()); },
+      py::call_guard<py::gil_scoped_release>(),
+      "Copy of the histogram of all events added so far.");
+}
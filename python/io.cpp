@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "scipp/core/io.h"
+
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace py = pybind11;
+
+template <class T> void bind_save(py::module &m) {
+  m.def(
+      "save",
+      [](const T &object, const std::string &filename) {
+        io::save(object, filename);
+      },
+      py::arg("x"), py::arg("filename"),
+      py::call_guard<py::gil_scoped_release>(),
+      R"(
+        Save a variable, data array, or dataset to a file in scipp's native binary format.
+
+        The file is written to a temporary location and moved into place once
+        complete, so objects previously loaded from the same file are not
+        affected.
+
+        :param x: Object to save.
+        :param filename: Name of the file.
+        :raises: If the dtype of a variable is not supported, or if the file cannot be written.
+        :seealso: :py:func:`scipp.load`)");
+}
+
+/// Objects returned to Python. Packed events are returned as sparse variables.
+using loaded_t = std::variant<Variable, DataArray, Dataset>;
+
+void init_io(py::module &m) {
+  bind_save<VariableConstView>(m);
+  bind_save<DataArrayConstView>(m);
+  bind_save<DatasetConstView>(m);
+
+  m.def(
+      "load",
+      [](const std::string &filename) -> loaded_t {
+        py::gil_scoped_release release;
+        return std::visit(
+            [](auto &&object) -> loaded_t {
+              using T = std::decay_t<decltype(object)>;
+              if constexpr (std::is_same_v<T, PackedEvents>)
+                return sparse::unpack(object);
+              else
+                return std::move(object);
+            },
+            io::load(filename));
+      },
+      py::arg("filename"),
+      R"(
+        Load a variable, data array, or dataset from a file written by :py:func:`scipp.save`.
+
+        The file is memory-mapped. Only metadata is read on load, the data of
+        dense variables is read from disk on first access. Modifications of
+        the loaded object are private and never written back to the file.
+        Files must be loaded on a machine with the same byte order and with
+        the scipp version used to write them.
+
+        :param filename: Name of the file.
+        :raises: If the file does not exist, is not a scipp file, or is corrupt.
+        :seealso: :py:func:`scipp.save`
+        :return: Object stored in the file.
+        :rtype: Variable, DataArray, or Dataset)");
+}
@@ -5,6 +5,7 @@
 #ifndef SCIPPY_NUMPY_H
 #define SCIPPY_NUMPY_H
 
+#include "scipp/core/parallel.h"
 #include "scipp/core/variable.h"
 
 #include "pybind11.h"
@@ -13,71 +14,55 @@ namespace py = pybind11;
 using namespace scipp;
 using namespace scipp::core;
 
-template <class T, class View>
-void copy_flattened_0d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  *it = r();
-}
-
-template <class T, class View>
-void copy_flattened_1d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i, ++it)
-    *it = r(i);
-}
-
-template <class T, class View>
-void copy_flattened_2d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j, ++it)
-      *it = r(i, j);
-}
-
-template <class T, class View>
-void copy_flattened_3d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j)
-      for (ssize_t k = 0; k < r.shape(2); ++k, ++it)
-        *it = r(i, j, k);
-}
-
-template <class T, class View>
-void copy_flattened_4d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (ssize_t i = 0; i < r.shape(0); ++i)
-    for (ssize_t j = 0; j < r.shape(1); ++j)
-      for (ssize_t k = 0; k < r.shape(2); ++k)
-        for (ssize_t l = 0; l < r.shape(3); ++l, ++it)
-          *it = r(i, j, k, l);
+/// Copy elements [begin, end) of `data`, in C order, to `out`, for arbitrary
+/// strides of `data`.
+template <class T, class Iter>
+void copy_strided(const py::array_t<T> &data, const scipp::index begin,
+                  const scipp::index end, Iter out) {
+  const auto ndim = data.ndim();
+  std::array<ssize_t, NDIM_MAX> index{};
+  const char *ptr = reinterpret_cast<const char *>(data.data());
+  auto remainder = begin;
+  for (auto d = ndim - 1; d >= 0; --d) {
+    index[d] = remainder % data.shape(d);
+    remainder /= data.shape(d);
+    ptr += index[d] * data.strides(d);
+  }
+  for (auto i = begin; i < end; ++i, ++out) {
+    *out = *reinterpret_cast<const T *>(ptr);
+    for (auto d = ndim - 1; d >= 0; --d) {
+      ptr += data.strides(d);
+      if (++index[d] < data.shape(d))
+        break;
+      ptr -= data.shape(d) * data.strides(d);
+      index[d] = 0;
+    }
+  }
 }
 
+/// Copy the elements of `data` in C order to `view`, in parallel.
+///
+/// C-contiguous input is copied as a flat range, any other input using its
+/// strides. Unlike iterating with `unchecked()` this supports any number of
+/// dimensions up to NDIM_MAX.
 template <class T, class View>
 void copy_flattened(const py::array_t<T> &data, View &&view) {
   if (scipp::size(view) != data.size())
     throw std::runtime_error(
         "Numpy data size does not match size of target object.");
-  switch (data.ndim()) {
-  case 0:
-    return copy_flattened_0d(data, view);
-  case 1:
-    return copy_flattened_1d(data, view);
-  case 2:
-    return copy_flattened_2d(data, view);
-  case 3:
-    return copy_flattened_3d(data, view);
-  case 4:
-    return copy_flattened_4d(data, view);
-  default:
+  if (data.ndim() > NDIM_MAX)
     throw std::runtime_error("Numpy array has more dimensions than supported "
                              "in the current implementation.");
-  }
+  const bool contiguous = data.flags() & py::array::c_style;
+  const T *ptr = data.data();
+  parallel::parallel_for(
+      parallel::blocked_range(0, data.size()), [&](const auto &range) {
+        auto out = view.begin() + range.begin();
+        if (contiguous)
+          std::copy(ptr + range.begin(), ptr + range.end(), out);
+        else
+          copy_strided(data, range.begin(), range.end(), out);
+      });
 }
 
 #endif // SCIPPY_NUMPY_H
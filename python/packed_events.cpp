@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "scipp/core/except.h"
+#include "scipp/core/packed_events.h"
+#include "scipp/core/tag_util.h"
+
+#include "dtype.h"
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace py = pybind11;
+
+template <class T>
+using c_array_t = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+template <class T>
+Variable make_buffer(const Dim dim, const c_array_t<T> &values,
+                     const std::optional<c_array_t<T>> &variances) {
+  const auto size = values.size();
+  const T *v = values.data();
+  if (!variances)
+    return makeVariable<T>(Dims{dim}, Shape{size}, Values(v, v + size));
+  const T *e = variances->data();
+  return makeVariable<T>(Dims{dim}, Shape{size}, Values(v, v + size),
+                         Variances(e, e + size));
+}
+
+template <class T> struct MakeSparseFromFlat {
+  static Variable apply(const std::vector<Dim> &labels,
+                        const py::array &offsets, const py::array &values,
+                        const std::optional<py::array> &variances,
+                        const units::Unit unit) {
+    if (labels.size() != 2)
+      throw except::DimensionError(
+          "Expected two dimension labels, the dimension of the event lists "
+          "and the sparse dimension.");
+    const c_array_t<scipp::index> offsetsT(offsets);
+    const c_array_t<T> valuesT(values);
+    std::optional<c_array_t<T>> variancesT;
+    if (variances)
+      variancesT.emplace(*variances);
+    if (offsetsT.ndim() != 1 || valuesT.ndim() != 1 ||
+        (variancesT && variancesT->ndim() != 1))
+      throw except::DimensionError(
+          "Expected 1-dimensional offsets, values, and variances.");
+    if (variancesT && variancesT->size() != valuesT.size())
+      throw except::SizeError("Values and variances must have same size.");
+    // The arrays are kept alive by the references held above, so we can
+    // release the GIL while copying and creating the event lists.
+    py::gil_scoped_release release;
+    const scipp::index size = offsetsT.size();
+    const scipp::index *o = offsetsT.data();
+    auto events = sparse::from_offsets(
+        makeVariable<scipp::index>(Dims{labels[0]}, Shape{size},
+                                   Values(o, o + size)),
+        make_buffer<T>(labels[1], valuesT, variancesT));
+    auto var = sparse::unpack(events);
+    var.setUnit(unit);
+    return var;
+  }
+};
+
+/// Packed events and offsets owned by the numpy arrays returned by
+/// `sparse_to_flat`.
+struct FlatEvents {
+  PackedEvents events;
+  Variable offsets;
+};
+
+template <class T> struct MakeFlatArrays {
+  static py::tuple apply(std::unique_ptr<FlatEvents> flat) {
+    const auto &buffer = flat->events.buffer();
+    const auto values = buffer.values<T>();
+    const auto variances =
+        buffer.hasVariances() ? buffer.variances<T>() : scipp::span<const T>{};
+    const auto offsets = std::as_const(flat->offsets).values<scipp::index>();
+    py::capsule owner(flat.release(), [](void *p) {
+      delete reinterpret_cast<FlatEvents *>(p);
+    });
+    return py::make_tuple(
+        py::array_t<scipp::index>(offsets.size(), offsets.data(), owner),
+        py::array_t<T>(values.size(), values.data(), owner),
+        buffer.hasVariances()
+            ? py::object(
+                  py::array_t<T>(variances.size(), variances.data(), owner))
+            : py::object(py::none()));
+  }
+};
+
+py::tuple sparse_to_flat(const VariableConstView &var) {
+  std::unique_ptr<FlatEvents> flat;
+  {
+    py::gil_scoped_release release;
+    auto events = sparse::pack(var);
+    auto offsets = sparse::offsets(events);
+    flat = std::make_unique<FlatEvents>(
+        FlatEvents{std::move(events), std::move(offsets)});
+  }
+  const auto dtype = flat->events.dtype();
+  return CallDType<double, float, int64_t, int32_t>::apply<MakeFlatArrays>(
+      dtype, std::move(flat));
+}
+
+void init_packed_events(py::module &m) {
+  m.def(
+      "sparse_from_flat",
+      [](const std::vector<Dim> &labels, const py::array &offsets,
+         const py::array &values, const std::optional<py::array> &variances,
+         const units::Unit &unit, const py::object &dtype) {
+        return CallDType<double, float, int64_t, int32_t>::apply<
+            MakeSparseFromFlat>(dtype.is_none() ? scipp_dtype(values.dtype())
+                                                : scipp_dtype(dtype),
+                                labels, offsets, values, variances, unit);
+      },
+      py::arg("dims"), py::arg("offsets"), py::arg("values"),
+      py::arg("variances") = std::nullopt,
+      py::arg("unit") = units::Unit(units::dimensionless),
+      py::arg("dtype") = py::none(),
+      R"(
+        Create a sparse variable from a flat array of events and offsets.
+
+        This is the compressed sparse row format used by event files, e.g.,
+        NeXus. Event list `i` contains the events `values[offsets[i]:offsets[i + 1]]`.
+        All event lists are created in a single pass without holding the GIL.
+
+        :param dims: Dimension labels. The first is the dimension of the event lists, the second is the sparse dimension.
+        :param offsets: 1-D array with event list offsets, one more than the number of event lists.
+        :param values: 1-D array with all events.
+        :param variances: Optional 1-D array with the variances of all events.
+        :param unit: Unit of the events.
+        :param dtype: Data type of the events, defaults to the dtype of `values`.
+        :raises: If the offsets are not monotonic or out of range.
+        :seealso: :py:func:`scipp.sparse_to_flat`
+        :return: New sparse variable.
+        :rtype: Variable)");
+
+  m.def("sparse_to_flat", &sparse_to_flat, py::arg("x"),
+        R"(
+        Export a 1-D sparse variable to a flat array of events and offsets.
+
+        This is the inverse of :py:func:`scipp.sparse_from_flat`. The events
+        are copied once into a single buffer that is shared by the returned
+        arrays, without holding the GIL.
+
+        :param x: Sparse variable with a single dense dimension.
+        :return: Offsets, values, and variances (None if `x` has no variances).
+        :rtype: tuple)");
+}
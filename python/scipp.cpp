@@ -11,9 +11,13 @@ void init_detail(py::module &);
 void init_dimensions(py::module &);
 void init_dtype(py::module &);
 void init_counts(py::module &);
+void init_event_stream(py::module &);
 void init_groupby(py::module &);
+void init_histogram_accumulator(py::module &);
+void init_io(py::module &);
 void init_neutron(py::module &);
 void init_operations(py::module &);
+void init_packed_events(py::module &);
 void init_sparse_container(py::module &);
 void init_units_neutron(py::module &);
 void init_variable(py::module &);
@@ -26,8 +30,12 @@ void init_core(py::module &m) {
   init_dataset(core);
   init_dimensions(core);
   init_dtype(core);
+  init_event_stream(core);
   init_groupby(core);
+  init_histogram_accumulator(core);
+  init_io(core);
   init_operations(core);
+  init_packed_events(core);
   init_sparse_container(core);
   init_variable(core);
   init_element_array_view(core);
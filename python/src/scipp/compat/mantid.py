@@ -372,30 +372,48 @@ def convert_EventWorkspace_to_data_array(ws, load_pulse_times=True, **ignored):
     spec_dim, spec_coord = init_spec_axis(ws)
     nHist = ws.getNumberHistograms()
 
-    coord = sc.Variable([spec_dim, dim],
-                        shape=[nHist, sc.Dimensions.Sparse],
-                        unit=unit)
-    if load_pulse_times:
-        labs = sc.Variable([spec_dim, dim],
-                           shape=[nHist, sc.Dimensions.Sparse],
-                           dtype=sc.dtype.int64)
-
     # Check for weighted events
     evtp = ws.getSpectrum(0).getEventType()
     contains_weighted_events = ((evtp == EventType.WEIGHTED)
                                 or (evtp == EventType.WEIGHTED_NOTIME))
-    if contains_weighted_events:
-        weights = sc.Variable([spec_dim, dim],
-                              shape=[nHist, sc.Dimensions.Sparse])
 
+    tofs = []
+    pulse_times = []
+    weight_values = []
+    weight_errors = []
     for i in range(nHist):
         sp = ws.getSpectrum(i)
-        coord[spec_dim, i].values = sp.getTofs()
+        tofs.append(sp.getTofs())
         if load_pulse_times:
-            labs[spec_dim, i].values = sp.getPulseTimesAsNumpy()
+            pulse_times.append(sp.getPulseTimesAsNumpy())
         if contains_weighted_events:
-            weights[spec_dim, i].values = sp.getWeights()
-            weights[spec_dim, i].variances = sp.getWeightErrors()
+            weight_values.append(sp.getWeights())
+            weight_errors.append(sp.getWeightErrors())
+
+    # Create all event lists at once from flat arrays, instead of filling
+    # them one spectrum at a time.
+    offsets = np.zeros(nHist + 1, dtype=np.int64)
+    np.cumsum([len(t) for t in tofs], out=offsets[1:])
+
+    def concatenate(arrays):
+        return np.concatenate(arrays) if arrays else np.empty(0)
+
+    coord = sc.sparse_from_flat([spec_dim, dim],
+                                offsets,
+                                concatenate(tofs),
+                                unit=unit,
+                                dtype=sc.dtype.float64)
+    if load_pulse_times:
+        labs = sc.sparse_from_flat([spec_dim, dim],
+                                   offsets,
+                                   concatenate(pulse_times),
+                                   dtype=sc.dtype.int64)
+    if contains_weighted_events:
+        weights = sc.sparse_from_flat([spec_dim, dim],
+                                      offsets,
+                                      concatenate(weight_values),
+                                      variances=concatenate(weight_errors),
+                                      dtype=sc.dtype.float64)
 
     coords_labs_data = _convert_MatrixWorkspace_info(ws)
     coords_labs_data["coords"][dim] = coord
@@ -455,6 +455,42 @@ def test_dataset_histogram():
         h["s1"].values, np.array([[1.0, 0.0, 0.0, 0.0], [0.0, 0.0, 0.0, 0.0]]))
 
 
+def test_histogram_accumulator():
+    var = sc.Variable(dims=[Dim.X, Dim.Y], shape=[2, sc.Dimensions.Sparse])
+    var[Dim.X, 0].values = np.arange(3)
+    var[Dim.X, 1].values = np.ones(6)
+    events = sc.DataArray(coords={Dim.Y: var})
+    edges = sc.Variable(values=np.arange(5, dtype=np.float64), dims=[Dim.Y])
+    accumulator = sc.HistogramAccumulator(dims=[Dim.X], shape=[2], bins=edges)
+    accumulator.add(events[Dim.X, 1:2], dim=Dim.X, begin=1, end=2)
+    accumulator.add(events[Dim.X, 0:1], dim=Dim.X, begin=0, end=1)
+    accumulator.add(index=sc.Variable([Dim.Row], values=np.array([0, 1, 1])),
+                    coord=sc.Variable([Dim.Row], values=[3.5, 2.5, 9.0]))
+    assert np.array_equal(
+        accumulator.result.values,
+        np.array([[1.0, 1.0, 1.0, 1.0], [0.0, 6.0, 1.0, 0.0]]))
+    assert accumulator.result.coords[Dim.Y] == edges
+
+
+def test_event_stream():
+    var = sc.Variable(dims=[Dim.X, Dim.Y], shape=[2, sc.Dimensions.Sparse])
+    var[Dim.X, 0].values = np.arange(3)
+    stream = sc.EventStream(sc.DataArray(coords={Dim.Y: var}))
+    edges = sc.Variable(values=np.arange(5, dtype=np.float64), dims=[Dim.Y])
+    stream.add_histogram('h', edges)
+    # The events have no weights, so the data of the batch is ignored.
+    batch = sc.DataArray(
+        sc.Variable([Dim.Y], values=np.ones(3)),
+        coords={Dim.Y: sc.Variable([Dim.Y], values=[3.5, 2.5, 1.5])})
+    stream.append(index=sc.Variable([Dim.Y], values=np.array([0, 1, 1])),
+                  batch=batch)
+    assert len(stream.events.coords[Dim.Y][Dim.X, 0].values) == 4
+    assert len(stream.events.coords[Dim.Y][Dim.X, 1].values) == 2
+    assert np.array_equal(
+        stream.histogram('h').values,
+        np.array([[1.0, 1.0, 1.0, 1.0], [0.0, 1.0, 1.0, 0.0]]))
+
+
 def test_histogram_and_setitem():
     var = sc.Variable(dims=[Dim.X, Dim.Tof],
                       shape=[2, sc.Dimensions.Sparse],
@@ -0,0 +1,66 @@
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright (c) 2020 Scipp contributors (https://github.com/scipp)
+# @file
+import numpy as np
+import scipp as sc
+from scipp import Dim
+
+
+def make_dataset():
+    d = sc.Dataset(
+        {
+            'a': sc.Variable([Dim.X], values=np.arange(4.0),
+                             variances=np.ones(4)),
+            'b': sc.Variable([Dim.X], values=np.arange(4))
+        },
+        coords={Dim.X: sc.Variable([Dim.X], values=np.arange(5.0),
+                                   unit=sc.units.m)},
+        labels={'label': sc.Variable([Dim.X], values=['a', 'b', 'c', 'd'])})
+    d.masks['mask'] = sc.Variable([Dim.X], values=[True, False, True, False])
+    return d
+
+
+def test_save_load_variable(tmp_path):
+    filename = str(tmp_path / 'var.scipp')
+    var = sc.Variable([Dim.X, Dim.Y], values=np.random.rand(2, 3),
+                      unit=sc.units.us)
+    sc.save(var, filename)
+    assert sc.load(filename) == var
+
+
+def test_save_load_variable_slice(tmp_path):
+    filename = str(tmp_path / 'slice.scipp')
+    var = sc.Variable([Dim.X, Dim.Y], values=np.random.rand(2, 3))
+    sc.save(var[Dim.Y, 1:3], filename)
+    assert sc.load(filename) == var[Dim.Y, 1:3]
+
+
+def test_save_load_sparse_variable(tmp_path):
+    filename = str(tmp_path / 'sparse.scipp')
+    var = sc.Variable([Dim.X, Dim.Y], [2, sc.Dimensions.Sparse])
+    var.values[0] = np.arange(3.0)
+    sc.save(var, filename)
+    assert sc.load(filename) == var
+
+
+def test_save_load_data_array(tmp_path):
+    filename = str(tmp_path / 'array.scipp')
+    d = make_dataset()
+    sc.save(d['a'], filename)
+    assert sc.load(filename) == d['a']
+
+
+def test_save_load_dataset(tmp_path):
+    filename = str(tmp_path / 'dataset.scipp')
+    d = make_dataset()
+    sc.save(d, filename)
+    assert sc.load(filename) == d
+
+
+def test_loaded_variable_is_private(tmp_path):
+    filename = str(tmp_path / 'var.scipp')
+    var = sc.Variable([Dim.X], values=np.arange(3.0))
+    sc.save(var, filename)
+    loaded = sc.load(filename)
+    loaded *= 2.0
+    assert sc.load(filename) == var
@@ -325,6 +325,82 @@ def test_sparse_setitem_int64_t():
     assert len(var[Dim.X, 0].values) == 4
 
 
+def test_sparse_from_flat():
+    offsets = np.array([0, 2, 2, 5])
+    values = np.arange(5.0)
+    var = sc.sparse_from_flat([Dim.X, Dim.Y],
+                              offsets=offsets,
+                              values=values,
+                              variances=values * 2,
+                              unit=sc.units.us)
+    assert var.dims == [Dim.X]
+    assert var.sparse_dim == Dim.Y
+    assert var.unit == sc.units.us
+    assert np.array_equal(var[Dim.X, 0].values, [0.0, 1.0])
+    assert len(var[Dim.X, 1].values) == 0
+    assert np.array_equal(var[Dim.X, 2].values, [2.0, 3.0, 4.0])
+    assert np.array_equal(var[Dim.X, 2].variances, [4.0, 6.0, 8.0])
+
+
+def test_sparse_from_flat_dtype():
+    var = sc.sparse_from_flat([Dim.X, Dim.Y],
+                              offsets=np.array([0, 1]),
+                              values=np.array([1.5]),
+                              dtype=sc.dtype.float32)
+    assert var.dtype == sc.dtype.float32
+
+
+def test_sparse_from_flat_bad_offsets_fail():
+    with pytest.raises(IndexError):
+        sc.sparse_from_flat([Dim.X, Dim.Y],
+                            offsets=np.array([0, 2, 6]),
+                            values=np.arange(5.0))
+
+
+def test_sparse_to_flat():
+    var = sc.Variable([sc.Dim.X, sc.Dim.Y], [3, sc.Dimensions.Sparse],
+                      dtype=sc.dtype.int64)
+    var[Dim.X, 0].values = np.arange(2)
+    var[Dim.X, 2].values = np.arange(3)
+    offsets, values, variances = sc.sparse_to_flat(var)
+    assert np.array_equal(offsets, [0, 2, 2, 5])
+    assert np.array_equal(values, [0, 1, 0, 1, 2])
+    assert variances is None
+    assert sc.sparse_from_flat([Dim.X, Dim.Y], offsets, values) == var
+
+
+def test_create_copy_false_shares_buffer():
+    values = np.arange(6.0).reshape(2, 3)
+    var = sc.Variable([Dim.X, Dim.Y], values=values, copy=False)
+    values[1, 2] = -1.0
+    assert var.values[1, 2] == -1.0
+    var.values[0, 0] = 7.0
+    assert values[0, 0] == 7.0
+
+
+def test_create_copy_false_falls_back_to_copy():
+    values = np.arange(6.0).reshape(2, 3)
+    var = sc.Variable([Dim.Y, Dim.X], values=values.T, copy=False)
+    assert np.array_equal(var.values, values.T)
+    values[0, 0] = 7.0
+    assert var.values[0, 0] == 0.0
+
+
+def test_create_copies_by_default():
+    values = np.arange(4.0)
+    var = sc.Variable([Dim.X], values=values, variances=values)
+    values[0] = 7.0
+    assert var.values[0] == 0.0
+    assert var.variances[0] == 0.0
+
+
+def test_create_from_strided():
+    values = np.arange(2 * 3 * 4 * 5 * 6).reshape(2, 3, 4, 5, 6)
+    var = sc.Variable([Dim.X, Dim.Y, Dim.Z, Dim.Row, Dim.Tof],
+                      values=values[:, ::2, :, ::-1, 1:])
+    assert np.array_equal(var.values, values[:, ::2, :, ::-1, 1:])
+
+
 def test_create_dtype():
     var = sc.Variable([Dim.X], values=np.arange(4).astype(np.int64))
     assert var.dtype == sc.dtype.int64
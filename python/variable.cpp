@@ -27,28 +27,52 @@ using namespace scipp::core;
 
 namespace py = pybind11;
 
+/// Return element array with the elements of `array`.
+///
+/// If `array` is C-contiguous, aligned, and writeable its memory is adopted
+/// without copying, provided that either `copy` is false or `array` was
+/// obtained by converting `input`, i.e., is not referenced elsewhere. The
+/// element array then keeps `array` alive. Otherwise the elements are copied.
+template <class T>
+detail::element_array<T> to_element_array(const py::array_t<T> &array,
+                                          const py::array &input,
+                                          const bool copy) {
+  const bool aligned = array.flags() & py::detail::npy_api::NPY_ARRAY_ALIGNED_;
+  if ((!copy || !array.is(input)) && aligned && array.writeable() &&
+      (array.flags() & py::array::c_style)) {
+    // Variables may be destroyed without holding the GIL, which is required
+    // for releasing the reference to the array.
+    std::shared_ptr<const void> owner(new py::object(array),
+                                      [](py::object *obj) {
+                                        py::gil_scoped_acquire acquire;
+                                        delete obj;
+                                      });
+    return detail::element_array<T>(array.mutable_data(), array.size(),
+                                    std::move(owner));
+  }
+  detail::element_array<T> out(array.size(), detail::default_init_elements);
+  py::gil_scoped_release release;
+  copy_flattened<T>(array, scipp::span<T>(out.data(), out.size()));
+  return out;
+}
+
 template <class T> struct MakeVariable {
   static Variable apply(const std::vector<Dim> &labels, py::array values,
                         const std::optional<py::array> &variances,
-                        const units::Unit unit) {
+                        const units::Unit unit, const bool copy) {
     // Pybind11 converts py::array to py::array_t for us, with all sorts of
     // automatic conversions such as integer to double, if required.
     py::array_t<T> valuesT(values);
     py::buffer_info info = valuesT.request();
     Dimensions dims(labels, {info.shape.begin(), info.shape.end()});
-    auto var = variances
-                   ? makeVariable<T>(Dimensions{dims}, Values{}, Variances{})
-                   : makeVariable<T>(Dimensions(dims));
-    copy_flattened<T>(valuesT, var.template values<T>());
-    if (variances) {
-      py::array_t<T> variancesT(*variances);
-      info = variancesT.request();
-      expect::equals(
-          dims, Dimensions(labels, {info.shape.begin(), info.shape.end()}));
-      copy_flattened<T>(variancesT, var.template variances<T>());
-    }
-    var.setUnit(unit);
-    return var;
+    if (!variances)
+      return Variable(unit, dims, to_element_array(valuesT, values, copy));
+    py::array_t<T> variancesT(*variances);
+    info = variancesT.request();
+    expect::equals(dims,
+                   Dimensions(labels, {info.shape.begin(), info.shape.end()}));
+    return Variable(unit, dims, to_element_array(valuesT, values, copy),
+                    to_element_array(variancesT, *variances, copy));
   }
 };
 
@@ -113,7 +137,8 @@ auto do_init_0D(const T &value, const std::optional<T> &variance,
 
 Variable doMakeVariable(const std::vector<Dim> &labels, py::array &values,
                         std::optional<py::array> &variances,
-                        const units::Unit unit, const py::object &dtype) {
+                        const units::Unit unit, const py::object &dtype,
+                        const bool copy) {
   // Use custom dtype, otherwise dtype of data.
   const auto dtypeTag =
       dtype.is_none() ? scipp_dtype(values.dtype()) : scipp_dtype(dtype);
@@ -135,7 +160,7 @@ Variable doMakeVariable(const std::vector<Dim> &labels, py::array &values,
   }
 
   return CallDType<double, float, int64_t, int32_t, bool>::apply<MakeVariable>(
-      dtypeTag, labels, values, variances, unit);
+      dtypeTag, labels, values, variances, unit, copy);
 }
 
 Variable makeVariableDefaultInit(const std::vector<Dim> &labels,
@@ -254,7 +279,9 @@ void init_variable(py::module &m) {
   bind_init_0D<Dataset>(variable);
   bind_init_0D<std::string>(variable);
   bind_init_0D<Eigen::Vector3d>(variable);
-  variable.def(py::init<const VariableView &>())
+  variable
+      .def(py::init<const VariableView &>(),
+           py::call_guard<py::gil_scoped_release>())
       .def(py::init(&makeVariableDefaultInit),
            py::arg("dims") = std::vector<Dim>{},
            py::arg("shape") = std::vector<scipp::index>{},
@@ -265,7 +292,7 @@ void init_variable(py::module &m) {
            py::arg("values"), // py::array
            py::arg("variances") = std::nullopt,
            py::arg("unit") = units::Unit(units::dimensionless),
-           py::arg("dtype") = py::none())
+           py::arg("dtype") = py::none(), py::arg("copy") = true)
       .def("rename_dims", &rename_dims<Variable>, py::arg("dims_dict"),
            "Rename dimensions.")
       .def("copy", [](const Variable &self) { return self; },
@@ -273,16 +300,17 @@ void init_variable(py::module &m) {
       .def("__copy__", [](Variable &self) { return Variable(self); },
            py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.")
       .def("__deepcopy__",
-           [](Variable &self, py::dict) { return Variable(self); },
+           [](Variable &self, const py::dict &) { return Variable(self); },
            py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.")
       .def_property_readonly("dtype", &Variable::dtype)
       .def("__radd__", [](Variable &a, double &b) { return a + b; },
-           py::is_operator())
+           py::is_operator(), py::call_guard<py::gil_scoped_release>())
       .def("__rsub__", [](Variable &a, double &b) { return b - a; },
-           py::is_operator())
+           py::is_operator(), py::call_guard<py::gil_scoped_release>())
       .def("__rmul__", [](Variable &a, double &b) { return a * b; },
-           py::is_operator())
-      .def("__repr__", [](const Variable &self) { return to_string(self); });
+           py::is_operator(), py::call_guard<py::gil_scoped_release>())
+      .def("__repr__", [](const Variable &self) { return to_string(self); },
+           py::call_guard<py::gil_scoped_release>());
 
   bind_init_list(variable);
   // Order matters for pybind11's overload resolution. Do not change.
@@ -296,13 +324,16 @@ void init_variable(py::module &m) {
   py::class_<VariableConstView>(m, "VariableConstView")
       .def(py::init<const Variable &>())
       .def("copy", [](const VariableConstView &self) { return Variable(self); },
-           "Return a (deep) copy.")
+           py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.")
       .def("__copy__",
-           [](const VariableConstView &self) { return Variable(self); })
+           [](const VariableConstView &self) { return Variable(self); },
+           py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.")
       .def("__deepcopy__",
-           [](VariableView &self, py::dict) { return Variable(self); })
+           [](VariableView &self, const py::dict &) { return Variable(self); },
+           py::call_guard<py::gil_scoped_release>(), "Return a (deep) copy.")
       .def("__repr__",
-           [](const VariableConstView &self) { return to_string(self); });
+           [](const VariableConstView &self) { return to_string(self); },
+           py::call_guard<py::gil_scoped_release>());
 
   py::class_<VariableView, VariableConstView> variableView(
       m, "VariableView", py::buffer_protocol(), R"(
@@ -311,11 +342,11 @@ void init_variable(py::module &m) {
   variableView.def_buffer(&make_py_buffer_info);
   variableView.def(py::init<Variable &>())
       .def("__radd__", [](VariableView &a, double &b) { return a + b; },
-           py::is_operator())
+           py::is_operator(), py::call_guard<py::gil_scoped_release>())
       .def("__rsub__", [](VariableView &a, double &b) { return b - a; },
-           py::is_operator())
+           py::is_operator(), py::call_guard<py::gil_scoped_release>())
       .def("__rmul__", [](VariableView &a, double &b) { return a * b; },
-           py::is_operator());
+           py::is_operator(), py::call_guard<py::gil_scoped_release>());
 
   bind_astype(variable);
   bind_astype(variableView);
@@ -361,6 +392,7 @@ void init_variable(py::module &m) {
         [](const VariableView &self, const std::vector<Dim> &labels,
            const py::tuple &shape) {
           Dimensions dims(labels, shape.cast<std::vector<scipp::index>>());
+          py::gil_scoped_release release;
           return self.reshape(dims);
         },
         py::arg("x"), py::arg("dims"), py::arg("shape"), R"(